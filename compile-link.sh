@@ -6,11 +6,25 @@ echo "--- Compiling in Progress ---"
 rm -f error.txt 
 rm -f link 
 
-g++ -O3 \
+g++ -O3 -pthread \
     src/main.cpp \
     src/lexer.cpp \
     src/parser.cpp \
+    src/optimizer.cpp \
+    src/resolver.cpp \
+    src/compiler.cpp \
+    src/jit.cpp \
     src/help.cpp \
+    src/builtins.cpp \
+    src/intern.cpp \
+    src/memo.cpp \
+    src/gc.cpp \
+    src/slab.cpp \
+    src/arena.cpp \
+    src/astcache.cpp \
+    src/module.cpp \
+    src/prefetch.cpp \
+    src/image.cpp \
     src/os.cpp \
     src/link_str.cpp \
     src/link_math.cpp \
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Bump allocator untuk node AST. Satu Arena per Program: node dialokasikan berurutan
+// di chunk besar (urutan parse = urutan eksekusi, jadi rapat di cache), dan semua chunk
+// dilepas sekaligus saat Program dihapus. Destruktor node tetap jalan lewat unique_ptr,
+// tapi operator delete-nya tidak melakukan apa-apa.
+class Arena {
+public:
+    static constexpr size_t CHUNK_BYTES = 32 * 1024;
+
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    ~Arena();
+
+    void* allocate(size_t size) {
+        size = (size + 15) & ~size_t(15);
+        if (size > remaining) grow(size);
+        void* p = cursor;
+        cursor += size;
+        remaining -= size;
+        used += size;
+        return p;
+    }
+
+    size_t bytesUsed() const { return used; }
+    size_t chunkCount() const { return chunks; }
+
+    // Arena tujuan operator new node AST; di luar Scope dipakai arena global yang tidak pernah dilepas
+    static void* allocateNode(size_t size);
+
+    // Selama Scope hidup, node AST baru masuk ke 'arena' (dipakai Parser dan Optimizer)
+    class Scope {
+    public:
+        explicit Scope(Arena& arena);
+        ~Scope();
+    private:
+        Arena* previous;
+    };
+
+private:
+    char* cursor = nullptr;
+    size_t remaining = 0;
+    size_t used = 0;
+    size_t chunks = 0;
+    void* chunkList = nullptr; // tiap chunk diawali pointer ke chunk sebelumnya
+
+    void grow(size_t size);
+};
+
+// Dipasang di base Expr / Stmt
+#define LINK_ARENA_ALLOCATED \
+    static void* operator new(size_t size) { return Arena::allocateNode(size); } \
+    static void operator delete(void*) {}
@@ -3,8 +3,66 @@
 #include <vector>
 #include <memory>
 #include <iostream>
+#include "types.h"
+#include "intern.h"
+#include "arena.h"
+
+struct JitFunction;
+
+// Identifier di AST: pointer ke string intern (8 byte, dua Name sama kalau pointernya sama)
+class Name {
+public:
+    Name() = default;
+    Name(const std::string& text) : symbol(Intern::symbol(text)) {}
+    Name(const char* text) : symbol(Intern::symbol(text)) {}
+    Name(std::string_view text) : symbol(Intern::symbol(text)) {}
+
+    const std::string& str() const {
+        static const std::string none;
+        return symbol ? symbol->value : none;
+    }
+    operator const std::string&() const { return str(); }
+    const LinkString* key() const { return symbol; }
+    bool empty() const { return str().empty(); }
+
+    bool operator==(const Name& o) const { return symbol == o.symbol; }
+    bool operator!=(const Name& o) const { return symbol != o.symbol; }
+
+    // Hidden friend: hanya ikut overload resolution kalau salah satu operand memang Name
+    friend bool operator==(const Name& a, const std::string& b) { return a.str() == b; }
+    friend bool operator==(const Name& a, const char* b) { return a.str() == b; }
+    friend bool operator!=(const Name& a, const std::string& b) { return a.str() != b; }
+    friend bool operator!=(const Name& a, const char* b) { return a.str() != b; }
+    friend std::string operator+(const Name& a, const std::string& b) { return a.str() + b; }
+    friend std::string operator+(const std::string& a, const Name& b) { return a + b.str(); }
+    friend std::string operator+(const char* a, const Name& b) { return a + b.str(); }
+    friend std::ostream& operator<<(std::ostream& os, const Name& n) { return os << n.str(); }
+
+private:
+    const LinkString* symbol = nullptr;
+};
+
+// Lokasi variabel hasil Resolver: 'local' = slot di frame aktif (-1 kalau tidak ada),
+// 'global' = slot di globalEnv sebagai fallback terakhir.
+struct SlotRef {
+    int local = -1;
+    int global = -1;
+};
+
+// Inline cache monomorfik per callsite (diisi Runtime saat pertama kali lewat)
+struct FieldCache {
+    Shape* shape = nullptr; // shape instance yang terakhir terlihat
+    Shape* next = nullptr;  // SetExpr: shape hasil transisi kalau field baru ditambahkan
+    int slot = -1;
+};
+
+struct MethodCache {
+    const ClassDecl* klass = nullptr;
+    FuncDecl* method = nullptr;
+};
 
 struct Expr {
+    LINK_ARENA_ALLOCATED
     virtual ~Expr() = default;
     virtual void print() const = 0;
 };
@@ -29,6 +87,7 @@ struct FloatExpr : public Expr {
 
 struct StringExpr : public Expr {
     std::string value;
+    Obj constant; // versi intern, diisi Resolver
     StringExpr(std::string v) : value(v) {}
     void print() const override { std::cout << "\"" << value << "\""; }
 };
@@ -46,24 +105,28 @@ struct BoolExpr : public Expr {
 };
 
 struct VariableExpr : public Expr {
-    std::string name;
-    VariableExpr(std::string n) : name(n) {}
+    Name name;
+    SlotRef ref;
+    VariableExpr(Name n) : name(n) {}
     void print() const override { std::cout << name; }
 };
 
 struct CallExpr : public Expr {
-    std::string func;
+    Name func;
     std::vector<std::unique_ptr<Expr>> args;
-    CallExpr(const std::string& f, std::vector<std::unique_ptr<Expr>> a) : func(f), args(std::move(a)) {}
+    int builtin = -1;  // ID di tabel Builtins, diisi Resolver
+    int function = -1; // slot functionRegistry kalau bukan builtin
+    CallExpr(Name f, std::vector<std::unique_ptr<Expr>> a) : func(f), args(std::move(a)) {}
     void print() const override { std::cout << func << "(...)"; }
 };
 
 struct MethodCallExpr : public Expr {
     std::unique_ptr<Expr> object; 
-    std::string method;           
+    Name method;           
     std::vector<std::unique_ptr<Expr>> args; 
+    MethodCache cache;
     
-    MethodCallExpr(std::unique_ptr<Expr> o, std::string m, std::vector<std::unique_ptr<Expr>> a)
+    MethodCallExpr(std::unique_ptr<Expr> o, Name m, std::vector<std::unique_ptr<Expr>> a)
     : object(std::move(o)), method(m), args(std::move(a)) {}
     
     void print() const override {
@@ -73,15 +136,18 @@ struct MethodCallExpr : public Expr {
 
 struct ThisExpr : public Expr {
     Token keyword;
+    SlotRef ref;
     ThisExpr(Token k) : keyword(k) {}
     void print() const override { std::cout << "this"; }
 };
 
 struct GetExpr : public Expr {
     std::unique_ptr<Expr> object;
-    std::string name;
+    Name name;
+    const LinkString* key = nullptr; // nama intern, diisi Resolver
+    FieldCache cache;
     
-    GetExpr(std::unique_ptr<Expr> obj, std::string n) 
+    GetExpr(std::unique_ptr<Expr> obj, Name n) 
     : object(std::move(obj)), name(n) {}
     
     void print() const override { 
@@ -91,10 +157,12 @@ struct GetExpr : public Expr {
 
 struct SetExpr : public Expr {
     std::unique_ptr<Expr> object;
-    std::string name;
+    Name name;
     std::unique_ptr<Expr> value;
+    const LinkString* key = nullptr;
+    FieldCache cache;
     
-    SetExpr(std::unique_ptr<Expr> obj, std::string n, std::unique_ptr<Expr> v)
+    SetExpr(std::unique_ptr<Expr> obj, Name n, std::unique_ptr<Expr> v)
     : object(std::move(obj)), name(n), value(std::move(v)) {}
     
     void print() const override {
@@ -137,11 +205,13 @@ struct BinaryExpr : public Expr {
 };
 
 struct Stmt {
+    LINK_ARENA_ALLOCATED
     virtual ~Stmt() = default;
     virtual void print(int indent = 0) = 0;
 };
 
 struct Program {
+    Arena arena; // dideklarasikan duluan: dilepas setelah semua node dihancurkan
     std::vector<std::unique_ptr<Stmt>> statements;
     void print() const { for (auto& stmt : statements) stmt->print(0); }
 };
@@ -151,9 +221,10 @@ struct ClearStmt : public Stmt {
 };
 
 struct SetStmt : public Stmt {
-    std::string name;
+    Name name;
+    SlotRef ref;
     std::unique_ptr<Expr> expression;
-    SetStmt(const std::string& n, std::unique_ptr<Expr> e) : name(n), expression(std::move(e)) {}
+    SetStmt(Name n, std::unique_ptr<Expr> e) : name(n), expression(std::move(e)) {}
     void print(int indent = 0) override {
         std::cout << std::string(indent, ' ') << "Set: " << name << " = ";
         if(expression) expression->print(); std::cout << "\n";
@@ -183,11 +254,12 @@ struct IfStmt : public Stmt {
 };
 
 struct ForStmt : public Stmt { 
-    std::string iteratorName;
+    Name iteratorName;
+    SlotRef ref;
     std::unique_ptr<Expr> collection; 
     std::vector<std::unique_ptr<Stmt>> body;
 
-    ForStmt(const std::string& iter, std::unique_ptr<Expr> col) 
+    ForStmt(Name iter, std::unique_ptr<Expr> col) 
         : iteratorName(iter), collection(std::move(col)) {}
         
     void print(int indent = 0) override { 
@@ -197,10 +269,19 @@ struct ForStmt : public Stmt {
 };
 
 struct FuncDecl : public Stmt {
-    std::string name;
-    std::vector<std::string> params;
+    Name name;
+    std::vector<Name> params;
     std::vector<std::unique_ptr<Stmt>> body;
-    FuncDecl(const std::string& n, std::vector<std::string> p) : name(n), params(std::move(p)) {}
+
+    // Layout frame (diisi Resolver): param di slot 0..n-1
+    int slot = -1; // posisi di functionRegistry
+    int frameSize = 0;
+    int thisSlot = -1;
+    std::vector<int> slotParents;
+    JitFunction* jit = nullptr; // milik Jit, diisi saat fungsi mulai dihitung panas
+    bool memo = false;          // 'memo func': hasil di-cache per nilai argumen (lihat memo.h)
+
+    FuncDecl(Name n, std::vector<Name> p) : name(n), params(std::move(p)) {}
     void print(int indent = 0) override {
         std::cout << std::string(indent, ' ') << "Func " << name << "\n";
         for (auto& stmt : body) stmt->print(indent + 2);
@@ -209,10 +290,11 @@ struct FuncDecl : public Stmt {
 
 // 4. Deklarasi Class (Cetakan)
 struct ClassDecl : public Stmt {
-    std::string name;
+    Name name;
+    SlotRef ref;
     std::vector<std::unique_ptr<FuncDecl>> methods; // Class isinya kumpulan fungsi (method)
 
-    ClassDecl(std::string n, std::vector<std::unique_ptr<FuncDecl>> m) 
+    ClassDecl(Name n, std::vector<std::unique_ptr<FuncDecl>> m) 
     : name(n), methods(std::move(m)) {}
 
     void print(int indent = 0) override {
@@ -221,19 +303,35 @@ struct ClassDecl : public Stmt {
     }
 };
 
+// Objek class dari deklarasinya (statement class di Runtime, juga saat memuat snapshot image)
+inline Ref<LinkClass> makeClass(ClassDecl* cls) {
+    auto klass = makeRef<LinkClass>();
+    klass->name = cls->name;
+    klass->decl = cls;
+    for (auto& method : cls->methods) {
+        klass->methods[method->name] = method.get();
+    }
+    auto init = klass->methods.find("init");
+    if (init != klass->methods.end()) klass->init = init->second;
+    return klass;
+}
+
 struct CallStmt : public Stmt {
-    std::string func;
+    Name func;
     std::vector<std::unique_ptr<Expr>> args;
-    CallStmt(const std::string& f, std::vector<std::unique_ptr<Expr>> a) : func(f), args(std::move(a)) {}
+    int builtin = -1;
+    int function = -1;
+    CallStmt(Name f, std::vector<std::unique_ptr<Expr>> a) : func(f), args(std::move(a)) {}
     void print(int indent = 0) override {
         std::cout << std::string(indent, ' ') << "Call " << func << "\n";
     }
 };
 
 struct UpdateStmt : public Stmt {
-    std::string name;
+    Name name;
+    SlotRef ref;
     std::string op;
-    UpdateStmt(const std::string& n, const std::string& o) : name(n), op(o) {}
+    UpdateStmt(Name n, const std::string& o) : name(n), op(o) {}
     void print(int indent = 0) override { std::cout << std::string(indent, ' ') << "Update " << name << "\n"; }
 };
 
@@ -266,6 +364,7 @@ struct ConnectStmt : public Stmt {
 
 struct ReturnStmt : public Stmt {
 	std::unique_ptr<Expr> value; 
+	bool tail = false; // 'return f(...)' di fungsi, di luar blok try: frame pemanggil dipakai ulang (diisi Resolver)
 	ReturnStmt(std::unique_ptr<Expr> v) : value(std::move(v)) {} 
 	
 	void print(int indent = 0) override {
@@ -276,37 +375,42 @@ struct ReturnStmt : public Stmt {
 
 struct ImportStmt : public Stmt { 
 	std::string path; 
+	std::string canonical; // diisi Runtime saat import pertama: key ModuleRegistry
+	bool lazy = false;     // 'lazy import': modul baru dijalankan saat namanya pertama dipakai
 	ImportStmt(std::string p) : path(p) {}
 	
 	void print(int indent = 0) override {
-		std::cout << std::string(indent, ' ') << "Import: " << path << "\n"; 
+		std::cout << std::string(indent, ' ') << (lazy ? "Lazy Import: " : "Import: ") << path << "\n"; 
 	}
 }; 
 
 struct TryStmt : public Stmt {
     std::vector<std::unique_ptr<Stmt>> tryBody;
     std::vector<std::unique_ptr<Stmt>> catchBody;
-    std::string errorVar; // Nama variabel untuk menangkap pesan error (misal: "e")
+    Name errorVar; // Nama variabel untuk menangkap pesan error (misal: "e")
+    int errorSlot = -1;
+    std::vector<int> scopeSlots; // slot scope catch, di-reset tiap kali catch dijalankan
 
     TryStmt(std::vector<std::unique_ptr<Stmt>> tb, 
             std::vector<std::unique_ptr<Stmt>> cb, 
-            std::string ev) 
+            Name ev) 
     : tryBody(std::move(tb)), catchBody(std::move(cb)), errorVar(ev) {}
 
     void print(int indent = 0) override {
         std::cout << std::string(indent, ' ') << "Try\n";
-        for (auto& s : tryBody) s->print(indent + 2);
+        for (auto& s : tryBody) if (s) s->print(indent + 2);
         std::cout << std::string(indent, ' ') << "Catch (" << errorVar << ")\n";
-        for (auto& s : catchBody) s->print(indent + 2);
+        for (auto& s : catchBody) if (s) s->print(indent + 2);
     }
 };
 
 // 5. Ekspresi 'new' (Membuat Instance)
 struct NewExpr : public Expr {
-    std::string className;
+    Name className;
+    SlotRef ref;
     std::vector<std::unique_ptr<Expr>> args;
     
-    NewExpr(std::string n, std::vector<std::unique_ptr<Expr>> a) 
+    NewExpr(Name n, std::vector<std::unique_ptr<Expr>> a) 
     : className(n), args(std::move(a)) {}
     
     void print() const override { std::cout << "new " << className << "(...)"; }
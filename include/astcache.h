@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "token.h"
+#include "ast.h"
+
+// Cache AST di disk: Program hasil parse + optimize disimpan biner di
+// __linkcache__/<nama file>.astc di sebelah file sumber. Cache hanya dipakai kalau path,
+// mtime, ukuran dan hash isi file sama; selain itu (atau file cache rusak / tidak bisa
+// ditulis) source di-parse seperti biasa. Hasil Resolver (slot, inline cache) tidak
+// disimpan, jadi Program dari cache tetap di-resolve oleh Runtime.
+namespace AstCache {
+    constexpr uint32_t FORMAT_VERSION = 2;
+
+    void setEnabled(bool on); // --no-cache
+    std::string cachePath(const std::string& sourcePath);
+
+    std::unique_ptr<Program> load(const std::string& sourcePath, std::string_view source);
+    bool store(const std::string& sourcePath, std::string_view source, const Program& program);
+
+    // Program siap di-resolve: dari cache kalau valid, selain itu lex + parse + optimize lalu
+    // cache ditulis. sourcePath kosong (REPL) = tanpa cache. Error parse dilempar seperti Parser.
+    std::unique_ptr<Program> compile(const std::string& sourcePath, std::string_view source);
+
+    // compile() dipecah dua untuk prefetch paralel: parse() aman dijalankan di thread worker
+    // (baca cache, atau lex + parse saja; cached = true kalau dari cache), finish() melakukan
+    // optimize + tulis cache untuk Program yang belum dari cache, di thread utama.
+    std::unique_ptr<Program> parse(const std::string& sourcePath, std::string_view source, bool& cached);
+    void finish(const std::string& sourcePath, std::string_view source, Program& program);
+
+    // Isi file cache tanpa header (tabel string + node), dipakai juga oleh snapshot image.
+    // decode() -> nullptr kalau data rusak.
+    std::string encode(const Program& program);
+    std::unique_ptr<Program> decode(std::string_view data);
+    uint64_t contentHash(std::string_view data);
+}
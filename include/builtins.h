@@ -0,0 +1,30 @@
+#pragma once
+#include <string>
+#include "types.h"
+
+// Tabel fungsi native (print, len, str.*, math.*, io.*, ...).
+// Resolver mengikat nama builtin ke ID sekali saja; Runtime/VM memanggil lewat ID.
+namespace Builtins {
+    using NativeFn = Obj (*)(Obj* args, int argc);
+
+    struct Native {
+        const char* name;
+        int arity;       // jumlah argumen yang dievaluasi, sisanya diabaikan
+        NativeFn fn;
+        NativeFn stmtFn; // versi khusus kalau dipanggil sebagai statement (nullptr = pakai fn)
+    };
+
+    constexpr int MAX_ARITY = 3;
+
+    int find(const std::string& name); // -1 kalau bukan builtin
+    const Native& get(int id);
+
+    // Argumen range(stop) / range(start, stop) / range(start, stop, step).
+    // Argumen non-int dianggap 0, step 0 = kosong. false kalau tanpa argumen (range() = nil).
+    bool rangeBounds(const Obj* args, int argc, int& start, int& step, int& count);
+
+    // Native melapor error lewat raise() lalu return nilai apa saja;
+    // pemanggil mengecek takeError() setelah tiap panggilan.
+    void raise(const std::string& message);
+    bool takeError(std::string& message);
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "token.h"
+#include "ast.h"
+#include "types.h"
+
+// Engine yang dipakai Runtime: tree-walker (default) atau bytecode VM
+enum class Engine { Walker, VM };
+
+enum class OpCode : uint8_t {
+    CONST,          // [k]          push constants[k]
+    NIL,            //              push nil
+    POP,            //              buang top
+    GET_VAR,        // [local, global]   push nilai variabel
+    DEFINE_VAR,     // [local, global]   define(pop)
+    INCR_VAR,       // [local, global]   var++ (int saja)
+    ADD, SUB, MUL, DIV, LT, GT, EQ,
+    JUMP,           // [target]
+    JUMP_IF_FALSE,  // [target]     pop, lompat kalau falsy
+    BUILD_LIST,     // [n]
+    BUILD_DICT,     // [n]          n pasangan key/value
+    INDEX,
+    GET_FIELD,      // [node]       GetExpr (inline cache ada di node)
+    SET_FIELD,      // [node]       obj, value -> value
+    CALL_NATIVE,    // [id, argc, stmt] builtin dari tabel Builtins
+    CALL,           // [slot, argc] fungsi user dari functionRegistry
+    TAIL_CALL,      // [slot, argc] 'return f(...)': frame aktif diganti, selalu diikuti RETURN
+    INVOKE,         // [node, argc] method call, obj di bawah argumen
+    NEW,            // [node, argc]
+    FOR_PREP,       // [local, global, end] cek list, define iterator, push index
+    FOR_NEXT,       // [local, global, end] assign item berikutnya atau selesai
+    RANGE_PREP,     // [local, global, end, argc] for x in range(...): push next, sisa, step (tanpa list)
+    RANGE_NEXT,     // [local, global, end]
+    TRY_BEGIN,      // [node, catch]
+    TRY_END,
+    EVAL_EXPR,      // [node]       fallback ke tree-walker
+    EXEC_STMT,      // [node]       fallback ke tree-walker
+    RETURN,
+    HALT
+};
+
+struct Chunk {
+    std::vector<uint8_t> code;
+    std::vector<Obj> constants;
+    std::vector<Expr*> exprs;
+    std::vector<Stmt*> stmts;
+
+    void emit(OpCode op) { code.push_back(static_cast<uint8_t>(op)); }
+
+    void emitOperand(uint32_t v) {
+        size_t at = code.size();
+        code.resize(at + sizeof(uint32_t));
+        std::memcpy(&code[at], &v, sizeof(uint32_t));
+    }
+
+    void patchOperand(size_t at, uint32_t v) { std::memcpy(&code[at], &v, sizeof(uint32_t)); }
+
+    uint32_t readOperand(size_t at) const {
+        uint32_t v;
+        std::memcpy(&v, &code[at], sizeof(uint32_t));
+        return v;
+    }
+};
+
+class Compiler {
+public:
+    // isFunction = true: chunk diakhiri "return nil", selain itu HALT
+    std::unique_ptr<Chunk> compile(const std::vector<std::unique_ptr<Stmt>>& body, bool isFunction);
+
+private:
+    Chunk* chunk = nullptr;
+
+    void compileBlock(const std::vector<std::unique_ptr<Stmt>>& body);
+    void compileStmt(Stmt* stmt);
+    void compileExpr(Expr* expr);
+    void compileRangeLoop(ForStmt* loop, CallExpr* range);
+    void compileCall(int builtin, int function, const std::vector<std::unique_ptr<Expr>>& args, bool asStatement);
+
+    void emitRef(const SlotRef& ref);
+    uint32_t addConstant(Obj value);
+    void emitFallback(Stmt* stmt);
+    void emitFallback(Expr* expr);
+    size_t emitJump(OpCode op);
+    void patchJump(size_t operandAt);
+};
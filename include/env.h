@@ -1,35 +1,51 @@
 // env.h
 #pragma once
 #include "types.h"
-#include <unordered_map>
-#include <string>
-#include <memory>
+#include <vector>
 
+// Frame variabel berbasis slot (index dari Resolver).
+// 'parents' menghubungkan slot scope catch ke slot bernama sama di scope luarnya.
 struct Environment {
-    Environment* enclosing;
-    std::unordered_map<std::string, Obj> values;
+    std::vector<Obj> slots;
+    std::vector<bool> defined;
+    const std::vector<int>* parents;
 
-    Environment(Environment* enc = nullptr) : enclosing(enc) {}
+    Environment(size_t size = 0, const std::vector<int>* p = nullptr)
+        : slots(size), defined(size, false), parents(p) {}
 
-    void define(const std::string& name, Obj val) {
-        values[name] = val;
+    void resize(size_t size) {
+        if (size <= slots.size()) return;
+        slots.resize(size);
+        defined.resize(size, false);
     }
 
-    Obj get(const std::string& name) {
-        if (values.count(name)) return values[name];
-        if (enclosing) return enclosing->get(name);
-        return Obj(); 
+    // Dipakai ulang dari pool frame Runtime: kapasitas vector tetap, tidak ada alokasi baru
+    void reset(size_t size, const std::vector<int>* p) {
+        slots.resize(size);
+        defined.assign(size, false);
+        parents = p;
     }
 
-    void assign(const std::string& name, Obj val) {
-        if (values.count(name)) {
-            values[name] = val;
-            return;
-        }
-        if (enclosing) {
-            enclosing->assign(name, val);
-            return;
+    void release() {
+        slots.clear();
+    }
+
+    void define(int slot, Obj val) {
+        slots[slot] = std::move(val);
+        defined[slot] = true;
+    }
+
+    void undefine(int slot) {
+        slots[slot] = Obj();
+        defined[slot] = false;
+    }
+
+    // Slot terisi terdekat mengikuti rantai parent, -1 kalau belum ada
+    int find(int slot) const {
+        while (slot >= 0) {
+            if (defined[slot]) return slot;
+            slot = parents ? (*parents)[slot] : -1;
         }
-        values[name] = val; 
+        return -1;
     }
 };
@@ -0,0 +1,21 @@
+#pragma once
+#include <cstddef>
+#include "types.h"
+
+// Cycle collector untuk list/dict/instance (trial deletion, Bacon & Rajan).
+// Refcount tetap membebaskan objek biasa; container yang refcount-nya turun tapi belum 0
+// dicatat sebagai kandidat akar siklus. Kandidat diproses di safe point interpreter
+// (antar statement di walker, JUMP/CALL di VM), maksimal SLICE_ROOTS kandidat per langkah.
+namespace Gc {
+    constexpr size_t SLICE_ROOTS = 2000;   // batas kandidat per langkah (jeda terbatas)
+    constexpr size_t MIN_HEAP = 4096;      // jumlah container minimum sebelum collection otomatis
+    constexpr size_t MAX_ROOTS = 100000;   // buffer kandidat sepenuh ini juga memicu collection
+
+    extern bool pending; // true: heap melewati ambang, jalankan step() di safe point berikutnya
+
+    // Satu slice collection otomatis; pending mati lagi setelah buffer kandidat habis
+    void step();
+
+    // Proses semua kandidat sekarang. Hasilnya perkiraan byte yang dibebaskan.
+    size_t collect();
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "token.h"
+#include "ast.h"
+
+// Snapshot image Runtime (--snapshot / --image): state global setelah script library selesai
+// jalan, supaya invocation berikutnya mulai dari state itu tanpa menjalankan ulang library.
+// Isinya AST semua loadedPrograms (format AstCache, tanpa hasil Resolver: di-resolve ulang
+// saat dimuat), registry modul, functionRegistry dan nilai global (graf objek; aliasing dan
+// siklus tetap). FuncDecl / ClassDecl disimpan sebagai (index program, urutan deklarasi).
+// Tidak ikut: memo cache, kode JIT, variabel sementara optimizer.
+namespace Image {
+    constexpr uint32_t FORMAT_VERSION = 1;
+    constexpr uint32_t NO_PROGRAM = UINT32_MAX;
+
+    struct ModuleInfo {
+        std::string path;           // kanonik
+        std::string name;           // seperti ditulis di import / command line
+        uint32_t program = NO_PROGRAM; // NO_PROGRAM: lazy import yang belum dimuat
+        long long size = -1, mtime = -1; // file sumber saat snapshot; berubah = image basi
+    };
+
+    struct State {
+        std::vector<const Program*> programs;        // save: dipinjam dari Runtime
+        std::vector<std::unique_ptr<Program>> owned; // load: hasil decode, urutan sama
+        std::vector<ModuleInfo> modules;
+        std::vector<std::pair<std::string, FuncDecl*>> functions; // nama -> isi functionRegistry
+        std::vector<std::pair<std::string, Obj>> globals;
+    };
+
+    bool save(const std::string& path, const State& state);
+    // false + 'error' kalau image tidak bisa dipakai (tidak ada, rusak, versi lain, source berubah)
+    bool load(const std::string& path, State& state, std::string& error);
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include "types.h"
+
+// Tabel string yang di-intern (literal, key dict literal, nama field/method).
+// String yang sama selalu menunjuk ke LinkString yang sama, jadi '==' cukup banding pointer.
+namespace Intern {
+    Obj get(std::string_view text);
+    const LinkString* symbol(std::string_view name); // untuk nama field/method
+    size_t size();
+}
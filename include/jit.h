@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "token.h"
+#include "ast.h"
+
+// Baseline JIT (Linux x86-64): fungsi Link yang hanya memakai int/double/bool, if/while,
+// for-in-range, return dan panggilan fungsi user dikompilasi ke kode mesin per kombinasi tipe argumen.
+// Fungsi lain (atau tipe argumen lain) tetap dijalankan interpreter.
+enum class JitType : uint8_t { None, Int, Double, Bool, Nil, Invalid }; // None = belum diketahui (rekursi)
+
+// Satu versi kode native untuk kombinasi tipe parameter tertentu
+struct JitSpec {
+    std::vector<JitType> params;
+    JitType ret = JitType::None;
+    void* code = nullptr; // nullptr = tidak bisa di-JIT (atau sedang dikompilasi)
+    bool compiling = false;
+};
+
+// Ditempel di FuncDecl::jit
+struct JitFunction {
+    FuncDecl* fn;
+    int calls = 0;
+    bool hasLoop = false; // fungsi dengan loop langsung dianggap panas
+    int cooldown = 0, backoff = 0; // setelah stack native habis: sisa panggilan yang lewat interpreter
+    std::vector<std::unique_ptr<JitSpec>> specs;
+};
+
+class Jit {
+public:
+    static const int CALL_THRESHOLD = 50;
+    static const int MAX_PARAMS = 16;
+    static const int MAX_SPECS = 4;
+    static const int MAX_BACKOFF = 1 << 16;
+    static const size_t STACK_RESERVE = 256 * 1024; // sisa stack C untuk interpreter setelah bail
+
+    explicit Jit(const std::vector<FuncDecl*>& registry) : registry(registry) {}
+    ~Jit();
+
+    static bool supported();
+
+    // args = nilai parameter 0..n-1. true kalau fungsi sudah dijalankan native dan hasilnya di 'result'.
+    bool call(FuncDecl* fn, const Obj* args, Obj& result);
+
+    // Kompilasi (atau ambil) versi fn untuk tipe parameter ini; nullptr kalau batas versi tercapai
+    JitSpec* specialize(FuncDecl* fn, const JitType* params, size_t count);
+
+    // Buang semua kode, misal setelah fungsi global didefinisikan ulang
+    void invalidate();
+
+    // Dibaca kode native lewat alamat absolut: prolog tiap fungsi membandingkan rsp dengan
+    // stackFloor; kalau sudah di bawahnya, overflow di-set dan semua frame native langsung
+    // keluar sampai ke call(), yang lalu menyerahkan panggilan itu ke interpreter.
+    uint64_t stackFloor = 0;
+    uint64_t overflow = 0;
+
+private:
+    const std::vector<FuncDecl*>& registry;
+    std::vector<std::unique_ptr<JitFunction>> functions;
+    std::vector<std::pair<void*, size_t>> pages;
+
+    JitFunction* entryFor(FuncDecl* fn);
+    void* install(const std::vector<uint8_t>& code);
+};
@@ -1,28 +1,36 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <string_view>
 #include "token.h"
 
 class Lexer {
 public:
-    explicit Lexer(const std::string& source);
+    explicit Lexer(std::string_view source);
     std::vector<Token> tokenize();
 
+    // Lex on demand: tambah token sampai 'tokens' berisi minimal 'want' token atau EOF_TOKEN sudah keluar
+    void scan(std::vector<Token>& tokens, size_t want);
+
 private:
-    const std::string& src;
+    std::string_view src;
     size_t pos;
     int line;
     int column;
+    bool finished = false; // EOF_TOKEN sudah dikeluarkan
 
     std::vector<int> indentStack;
 
     char peek() const;
     char advance();
     bool match(char expected);
+    void skipTo(const char* stop); // lompat ke hasil scan, kolom ikut maju
 
     void skipWhitespace();
     void skipComment();
-    Token makeToken(TokenType type, const std::string& value = "");
+    Token makeToken(TokenType type, size_t start, int startCol);
+    Token makeToken(TokenType type) { return makeToken(type, pos, column); }
+    Token symbol(TokenType type, size_t width);
 
     Token identifier();
     Token stringLiteral();
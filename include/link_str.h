@@ -6,6 +6,6 @@
 namespace SysString {
     std::string trim(const std::string& str);
     std::string replace(std::string str, const std::string& from, const std::string& to);
-    std::vector<std::string> split(std::string str, const std::string& delimiter);
+    std::vector<std::string> split(const std::string& str, const std::string& delimiter);
     std::string merge(const std::vector<std::string>& list, const std::string& delimiter);
 }
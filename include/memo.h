@@ -0,0 +1,22 @@
+#pragma once
+#include <cstddef>
+#include "types.h"
+
+struct FuncDecl;
+
+// Cache hasil 'memo func': key = (fungsi, nilai argumen), LRU dengan batas jumlah entry.
+// Hanya argumen dan hasil immutable (nil, int, double, char, bool, string) yang di-cache;
+// panggilan dengan list/dict/instance tetap dijalankan biasa.
+namespace Memo {
+    constexpr int MAX_ARGS = 8;
+    constexpr size_t DEFAULT_CAPACITY = 10000;
+
+    // true kalau hasil untuk argumen ini ada di cache (entry jadi yang terbaru)
+    bool lookup(const FuncDecl* fn, const Obj* args, int argc, Obj& result);
+    void store(const FuncDecl* fn, const Obj* args, int argc, const Obj& result);
+
+    void clear(); // dipanggil juga saat fungsi global didefinisikan ulang
+    size_t size();
+    size_t capacity();
+    void setCapacity(size_t entriesMax); // 0 = cache mati; entry terlama dibuang kalau melebihi batas
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "token.h"
+#include "ast.h"
+
+// Registry modul milik Runtime: satu entri per path kanonik (Sys::canonicalPath). Modul
+// dijalankan sekali; import berikutnya cukup satu lookup. Modul yang sedang dijalankan
+// ada di stack 'loading' sehingga import melingkar bisa dilaporkan dengan rantainya.
+// 'lazy import' mendaftarkan modul berstatus Lazy: file baru dijalankan saat salah satu
+// namanya pertama kali dipakai (lihat Runtime::loadLazy).
+struct Module {
+    enum class State { Lazy, Loading, Loaded };
+
+    std::string path;            // kanonik, key registry
+    std::string name;            // path seperti ditulis di import (untuk pesan error)
+    State state = State::Lazy;
+    Program* program = nullptr;  // milik Runtime::loadedPrograms
+
+    // Export = nama yang didefinisikan di scope global modul (diisi exportsOf setelah resolve)
+    std::vector<int> globals;    // slot globalEnv: set / class
+    std::vector<int> functions;  // slot functionRegistry
+
+    // Lazy: slot export yang sudah ditulis script sebelum modul dimuat. Nilai script dipakai
+    // lagi setelah modul jalan, seperti import biasa yang sudah jalan sebelum penulisan itu.
+    std::vector<int> claimedGlobals, claimedFunctions;
+};
+
+class ModuleRegistry {
+public:
+    Module* find(const std::string& path);
+
+    // Entri baru berstatus Loading dan masuk stack loading
+    Module& begin(const std::string& path, const std::string& name, Program* program);
+    // Entri baru berstatus Lazy (belum dibaca, tidak masuk stack loading)
+    Module& defer(const std::string& path, const std::string& name);
+    // Lazy -> Loading, setelah program-nya diisi
+    void start(Module& module);
+    // ok = false: entri dibuang supaya import berikutnya mencoba lagi
+    void finish(Module& module, bool ok);
+
+    // "a.link -> b.link -> a.link" untuk modul yang sedang Loading
+    std::string cycle(const Module& module) const;
+    size_t size() const { return modules.size(); }
+    std::vector<const Module*> list() const;
+
+private:
+    std::unordered_map<std::string, std::unique_ptr<Module>> modules;
+    std::vector<Module*> loading;
+};
+
+// Isi Module::globals / functions dari statement top-level program yang sudah di-resolve
+void exportsOf(Module& module);
+
+// Untuk lazy import: nama setelah 'set' / 'class' (global) dan 'func' (fungsi), cukup dengan
+// lexer tanpa parse. Bisa lebih banyak dari export sebenarnya (variabel lokal, method); nama
+// yang ternyata bukan export hanya membuat modul dimuat sedikit lebih awal.
+void declaredNames(std::string_view source, std::vector<std::string>& globals, std::vector<std::string>& functions);
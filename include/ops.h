@@ -0,0 +1,56 @@
+#pragma once
+#include <sstream>
+#include <string>
+#include "types.h"
+
+// Semantik operator & truthiness Link. Dipakai Runtime, VM dan Optimizer (constant folding),
+// jadi hasil folding selalu sama dengan hasil saat runtime.
+
+inline bool isTruthy(const Obj& val) {
+    if (val.isBool()) return val.asBool();
+    if (val.isInt()) return val.asInt() != 0;
+    if (val.isDouble()) return val.asDouble() != 0.0;
+    if (val.isList()) return val.asLazyList()->length() != 0;
+    return false; 
+}
+
+inline Obj binaryOp(char op, const Obj& left, const Obj& right) {
+    if (left.isString() && op == '+') {
+        const std::string& sLeft = left.asString();
+        if (right.isString()) {
+            const std::string& sRight = right.asString();
+            std::string result;
+            result.reserve(sLeft.size() + sRight.size());
+            result.append(sLeft).append(sRight);
+            return Obj(std::move(result));
+        }
+        std::string result = sLeft;
+        if (right.isInt()) result += std::to_string(right.asInt());
+        else if (right.isDouble()) {
+            std::ostringstream oss;
+            oss << right.asDouble();
+            result += oss.str();
+        }
+        return Obj(std::move(result));
+    }
+
+    if (left.isInt() && right.isInt()) {
+        int l = left.asInt(), r = right.asInt();
+        switch (op) {
+            case '+': return Obj(l + r); case '-': return Obj(l - r);
+            case '*': return Obj(l * r); case '/': return Obj((r != 0) ? l / r : 0);
+            case '<': return Obj(l < r); case '>': return Obj(l > r); case '=': return Obj(l == r);
+        }
+    } else if ((left.isDouble()||left.isInt()) && (right.isDouble()||right.isInt())) {
+        double l = left.isInt()?left.asInt():left.asDouble();
+        double r = right.isInt()?right.asInt():right.asDouble();
+        switch (op) {
+            case '+': return Obj(l + r); case '-': return Obj(l - r);
+            case '*': return Obj(l * r); case '/': return Obj((r != 0.0) ? l / r : 0.0);
+            case '<': return Obj(l < r); case '>': return Obj(l > r); case '=': return Obj(l == r);
+        }
+    } else if (left.isString() && right.isString()) {
+        if (op == '=') return Obj(left.sameString(right));
+    }
+    return Obj();
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "token.h"
+#include "ast.h"
+
+// Pass setelah Parser::parse(), sebelum Resolver:
+// - constant folding (termasuk minus unary yang di-parse sebagai "0 - x")
+// - cabang if/elif dengan kondisi konstan dibuang, cabang yang hidup disisipkan ke block induk
+// - ekspresi murni yang invariant di-hoist dari while/for ke variabel sementara sebelum loop
+class Optimizer {
+public:
+    void optimize(Program& program);
+
+    // Nama variabel sementara hasil hoisting ("$invN"), unik di semua Program.
+    // AstCache memberi nama baru saat memuat Program dari cache supaya tetap unik.
+    static std::string temporaryName();
+    static bool isTemporary(const std::string& name) { return name.rfind("$inv", 0) == 0; }
+
+private:
+    using Names = std::unordered_set<std::string>;
+
+    // Efek body loop yang relevan untuk hoisting
+    struct LoopEffects {
+        Names written;       // nama variabel yang di-set di dalam loop
+        bool mutates = false; // ada list.add: hasil len(...) bisa berubah
+        bool opaque = false;  // panggilan fungsi user / method / new / import: tidak di-hoist sama sekali
+    };
+
+    void optimizeBlock(std::vector<std::unique_ptr<Stmt>>& body);
+    void optimizeStmt(Stmt* stmt);
+    void fold(std::unique_ptr<Expr>& expr);
+
+    void scanBlock(const std::vector<std::unique_ptr<Stmt>>& body, LoopEffects& effects);
+    void scanExpr(Expr* expr, LoopEffects& effects);
+    bool isInvariant(Expr* expr, const LoopEffects& effects);
+    void hoistLoop(Stmt* loop, std::vector<std::unique_ptr<Stmt>>& out);
+    void hoistBlock(std::vector<std::unique_ptr<Stmt>>& body, const LoopEffects& effects, std::vector<std::unique_ptr<Stmt>>& out);
+    void hoistExpr(std::unique_ptr<Expr>& expr, const LoopEffects& effects, std::vector<std::unique_ptr<Stmt>>& out);
+};
@@ -1,10 +1,37 @@
 #pragma once
+#include <cstddef>
 #include <string>
+#include <string_view>
 
 namespace Sys {
+    // Isi file read-only tanpa salinan heap: di POSIX di-mmap, selain itu (atau kalau mmap
+    // gagal, mis. pipe) dibaca sekali ke buffer. text() valid selama objek ini hidup.
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool isOpen() const { return opened; }
+        std::string_view text() const { return std::string_view(data, length); }
+
+    private:
+        const char* data = nullptr;
+        size_t length = 0;
+        bool opened = false;
+        bool mapped = false;
+        std::string buffer;
+    };
+
     std::string readFile(const std::string& path);
     void writeFile(const std::string& path, const std::string& content, bool append);
     bool fileExists(const std::string& path);
+    long long fileSize(const std::string& path); // -1 kalau tidak bisa dibuka
+    long long fileTime(const std::string& path); // mtime (ns), -1 kalau tidak ada
+    std::string canonicalPath(const std::string& path); // absolut, symlink & ./.. diurai; path asli kalau gagal
+    bool makeDir(const std::string& path);       // true kalau sudah ada atau berhasil dibuat
+    int processId();
     void removeFile(const std::string& path);
 
     std::string exec(const char* cmd);
@@ -3,17 +3,26 @@
 #include <memory>
 #include "token.h"
 #include "ast.h"
+#include "lexer.h"
 
 class Parser {
 public:
-    Parser(const std::vector<Token>& tokens);
+    Parser(std::vector<Token> tokens, std::string_view source);
+    Parser(Lexer& lexer, std::string_view source); // token diambil dari lexer saat dibutuhkan
     std::unique_ptr<Program> parse();
+    std::unique_ptr<Program> parseNext();
 
 private:
-    const std::vector<Token>& tokens;
+    std::vector<Token> tokens;
+    Lexer* lexer = nullptr;
+    std::string_view src; // teks token dibaca langsung dari sini
     size_t current;
 
-    const Token& peek() const;
+    std::string_view lexeme(const Token& token) const { return token.text(src); }
+
+    const Token& peek();
+    const Token& lookahead(size_t n);
+    void fill(size_t count);
     const Token& advance();
     bool match(TokenType type);
     const Token& consume(TokenType type, const std::string& err);
@@ -44,5 +53,5 @@ private:
     std::unique_ptr<CallStmt> parseCall();
     std::unique_ptr<ConnectStmt> parseConnect();
 
-    bool isAtEnd() const;
+    bool isAtEnd();
 };
@@ -0,0 +1,51 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "token.h"
+#include "ast.h"
+#include "os.h"
+
+// Prefetch import: sebelum script utama jalan, semua 'import "..."' di dalamnya (transitif,
+// kecuali 'lazy import') dibaca dan di-parse paralel di thread pool, jadi waktu start ~ modul
+// terbesar, bukan jumlah semua modul. Runtime mengambil hasilnya saat statement import benar-benar dieksekusi; file
+// yang tidak pernah di-import (mis. di cabang if yang tidak lewat) dibuang saja.
+// Worker hanya menyentuh arena Program-nya sendiri dan Intern (dikunci). run() menunggu semua
+// worker selesai, jadi parse tidak pernah berjalan bersamaan dengan eksekusi.
+class Prefetch {
+public:
+    static constexpr unsigned MAX_THREADS = 8;
+
+    // rootPath = file script utama (tidak di-parse ulang kalau ada modul yang meng-import-nya)
+    void run(const Program& root, const std::string& rootPath);
+
+    // Program siap di-resolve untuk path kanonik, nullptr kalau tidak di-prefetch atau file
+    // sudah berubah sejak di-parse (ukuran, mtime atau hash isi beda). Error parse dilempar di sini, seperti AstCache::compile.
+    std::unique_ptr<Program> take(const std::string& canonicalPath);
+
+private:
+    struct Entry {
+        std::string path; // seperti ditulis di import (relatif ke cwd, sama dengan Runtime)
+        std::unique_ptr<Sys::MappedFile> source;
+        long long size = -1, mtime = -1;
+        uint64_t hash = 0; // AstCache::contentHash isi yang di-parse
+        std::unique_ptr<Program> program;
+        bool cached = false;
+        std::exception_ptr error;
+    };
+
+    std::unordered_map<std::string, Entry> entries; // key: path kanonik
+    std::vector<Entry*> queue;
+    std::mutex lock;
+    std::condition_variable changed;
+    unsigned active = 0;
+
+    void schedule(const std::vector<std::string>& paths); // dipanggil dengan 'lock' terpegang
+    void work();
+    static void parse(Entry& entry, std::vector<std::string>& imports);
+};
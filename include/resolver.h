@@ -0,0 +1,68 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "token.h"
+#include "ast.h"
+
+// Tabel slot global milik Runtime. Dipakai bersama oleh semua Program
+// (script utama, import, baris REPL) supaya nama global selalu dapat slot yang sama.
+struct GlobalTable {
+    std::unordered_map<std::string, int> slots;
+    std::vector<int> parents; // slot tersembunyi (scope catch top-level) menunjuk ke global aslinya
+    std::unordered_map<std::string, int> functions;
+
+    int slotFor(const std::string& name) {
+        auto it = slots.find(name);
+        if (it != slots.end()) return it->second;
+        int slot = (int)parents.size();
+        slots[name] = slot;
+        parents.push_back(-1);
+        return slot;
+    }
+
+    int hiddenSlot(int parent) {
+        parents.push_back(parent);
+        return (int)parents.size() - 1;
+    }
+
+    int functionSlot(const std::string& name) {
+        auto it = functions.find(name);
+        if (it != functions.end()) return it->second;
+        int slot = (int)functions.size();
+        functions[name] = slot;
+        return slot;
+    }
+
+    size_t size() const { return parents.size(); }
+};
+
+// Pass setelah Parser::parse(): mengganti nama variabel dengan index slot.
+// Semantik 'set' tetap sama: define di scope aktif, baca jatuh ke global kalau slot lokal belum terisi.
+class Resolver {
+public:
+    explicit Resolver(GlobalTable& g) : globals(g) {}
+    void resolve(Program& program);
+
+private:
+    using Scope = std::unordered_map<std::string, int>;
+
+    GlobalTable& globals;
+    FuncDecl* function = nullptr; // frame yang sedang di-resolve, nullptr = top-level
+    std::vector<Scope> scopes;    // scope di frame aktif; kosong = top-level di luar catch
+    int tryDepth = 0;             // > 0 di dalam blok try: return di sana bukan tail call
+
+    void declare(const std::vector<std::unique_ptr<Stmt>>& body, std::vector<std::string>& names);
+    int newSlot(int parent);
+    int outerSlot(const std::string& name);
+    void pushScope(const std::vector<std::string>& names);
+
+    SlotRef reference(const std::string& name);
+    SlotRef definition(const std::string& name);
+    void bindCall(const std::string& name, int& builtin, int& function);
+
+    void resolveFunction(FuncDecl* fn, bool isMethod);
+    void resolveBlock(const std::vector<std::unique_ptr<Stmt>>& body);
+    void resolveStmt(Stmt* stmt);
+    void resolveExpr(Expr* expr);
+};
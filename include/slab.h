@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <new>
+
+// Pool slab untuk objek heap Runtime yang ukurannya tetap (List, Dict, LinkInstance, LinkString).
+// Memori diambil per slab SLAB_BYTES lalu dipotong jadi slot; alokasi = pop free-list, free = push.
+// Slab tidak pernah dikembalikan ke OS. Build dengan -DLINK_NO_SLAB (misal untuk ASan)
+// membuat pool hanya mencatat statistik dan memakai operator new biasa.
+namespace Slab {
+    constexpr size_t SLAB_BYTES = 16 * 1024;
+
+    struct Stats {
+        const char* name;
+        size_t objectSize; // ukuran slot (kelipatan 16)
+        size_t live;       // objek yang sedang dipakai
+        size_t peak;
+        size_t allocs;     // total alokasi sejak start
+        size_t slabs;
+        size_t bytes;      // memori yang dipegang pool
+    };
+
+    class Pool {
+    public:
+        // constexpr: pool sudah siap sebelum inisialisasi dinamis global mana pun
+        constexpr Pool(const char* name, size_t objectSize)
+            : name(name), slotSize((objectSize + 15) / 16 * 16) {}
+
+        void* allocate() {
+            live++;
+            allocs++;
+            if (live > peak) peak = live;
+#ifdef LINK_NO_SLAB
+            return ::operator new(slotSize);
+#else
+            if (!freeList) grow();
+            FreeSlot* slot = freeList;
+            freeList = slot->next;
+            return slot;
+#endif
+        }
+
+        void release(void* p) {
+            live--;
+#ifdef LINK_NO_SLAB
+            ::operator delete(p);
+#else
+            FreeSlot* slot = static_cast<FreeSlot*>(p);
+            slot->next = freeList;
+            freeList = slot;
+#endif
+        }
+
+        Stats stats() const;
+
+    private:
+        struct FreeSlot { FreeSlot* next; };
+
+        const char* name;
+        size_t slotSize;
+        FreeSlot* freeList = nullptr;
+        void* slabList = nullptr; // tiap slab diawali pointer ke slab sebelumnya
+        size_t live = 0, peak = 0, allocs = 0, slabs = 0;
+
+        void grow();
+    };
+
+    extern Pool lists;
+    extern Pool dicts;
+    extern Pool instances;
+    extern Pool strings;
+
+    // Semua pool, untuk sys.heapStats()
+    size_t count();
+    Stats stats(size_t i);
+}
+
+// Dipasang di struct objek heap: new/delete lewat pool slab
+#define LINK_SLAB_ALLOCATED(pool) \
+    static void* operator new(size_t) { return Slab::pool.allocate(); } \
+    static void operator delete(void* p) { Slab::pool.release(p); }
@@ -1,5 +1,7 @@
 #pragma once
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 enum class TokenType {
     // Keywords
@@ -29,9 +31,18 @@ enum class TokenType {
     LT, GT, EQ_EQ 
 };
 
+// Token tidak menyimpan teks: hanya posisi di source (source harus hidup selama parsing).
+// Literal angka sudah di-parse oleh Lexer.
 struct Token {
     TokenType type;
-    std::string value;
+    uint32_t offset;
+    uint32_t length;
     int line;
     int column;
+    union {
+        int intValue;      // TOKEN_NUM
+        double floatValue; // TOKEN_FLOAT
+    };
+
+    std::string_view text(std::string_view source) const { return source.substr(offset, length); }
 };
@@ -1,80 +1,313 @@
 #pragma once
-#include <variant>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <memory>
 #include <unordered_map>
 #include <iostream>
-#include "os.h" 
+#include "os.h"
+#include "slab.h"
 
 struct Value;
-struct Stmt;         
-struct LinkClass;    
-struct LinkInstance; 
+struct Stmt;
+struct List;
+struct Dict;
+struct LinkClass;
+struct LinkInstance;
+struct LinkString;
+struct FuncDecl;
+struct ClassDecl;
+template <typename T> class Ref;
 
-using List = std::vector<Value>;
-using Dict = std::unordered_map<std::string, Value>;
+// Urutan penting: semua tipe mulai dari String disimpan di heap
+enum class Type : uint8_t { Nil, Int, Double, Char, Bool, String, List, Dict, Class, Instance };
 
+struct HeapObject;
+
+// Cycle collector (gc.h): container yang refcount-nya turun tapi belum 0 jadi kandidat akar siklus
+namespace Gc {
+    extern size_t containers; // list/dict/instance yang masih hidup, dasar ambang collection
+    void possibleRoot(HeapObject* o);
+    void releaseBuffered(HeapObject* o);
+}
+
+inline bool isContainerType(Type t) { return t == Type::List || t == Type::Dict || t == Type::Instance; }
+
+// Header semua objek heap: refcount intrusif (interpreter single-thread, tidak perlu atomic)
+struct HeapObject {
+    uint32_t refs = 0;
+    Type type;
+    uint8_t gcColor = 0;     // dipakai collector selama satu collection
+    bool gcBuffered = false; // ada di buffer kandidat collector
+    explicit HeapObject(Type t) : type(t) { if (isContainerType(t)) Gc::containers++; }
+    ~HeapObject() { if (isContainerType(type)) Gc::containers--; }
+};
+
+inline void retainHeap(HeapObject* o) { o->refs++; }
+inline void releaseHeap(HeapObject* o);
+
+// Value 16 byte: tag + union. Angka/bool/char disimpan langsung,
+// string/list/dict/class/instance lewat pointer ber-refcount, jadi copy = salin 16 byte + refs++.
 struct Value {
-    using ValVariant = std::variant<
-        std::monostate, 
-        int, 
-        double, 
-        std::string, 
-        char, 
-        bool, 
-        std::shared_ptr<List>, 
-        std::shared_ptr<Dict>,
-        std::shared_ptr<LinkClass>, 
-        std::shared_ptr<LinkInstance>
-    >;
-    
-    ValVariant as;
-
-    Value() : as(std::monostate{}) {}
-    Value(int v) : as(v) {}
-    Value(double v) : as(v) {}
-    Value(std::string v) : as(v) {}
-    Value(const char* v) : as(std::string(v)) {} 
-    Value(char v) : as(v) {}
-    Value(bool v) : as(v) {}
-    Value(std::shared_ptr<List> v) : as(v) {}
-    Value(std::shared_ptr<Dict> v) : as(v) {}
-    
-    // [BARU] Constructor untuk OOP
-    Value(std::shared_ptr<LinkClass> v) : as(v) {}
-    Value(std::shared_ptr<LinkInstance> v) : as(v) {}
+    Type type;
+    union {
+        int i;
+        double d;
+        char c;
+        bool b;
+        HeapObject* heap;
+        uint64_t bits;
+    };
+
+    Value() : type(Type::Nil), bits(0) {}
+    Value(int v) : type(Type::Int), bits(0) { i = v; }
+    Value(double v) : type(Type::Double) { d = v; }
+    Value(const std::string& v);
+    Value(std::string&& v);
+    Value(const char* v);
+    Value(char v) : type(Type::Char), bits(0) { c = v; }
+    Value(bool v) : type(Type::Bool), bits(0) { b = v; }
+
+    // [BARU] Dari pointer objek heap (refcount ikut naik)
+    Value(List* v);
+    Value(Dict* v);
+    Value(LinkClass* v);
+    Value(LinkInstance* v);
+    template <typename T> Value(const Ref<T>& v) : Value(v.get()) {}
+
+    Value(const Value& o) : type(o.type), bits(o.bits) {
+        if (isHeap()) retainHeap(heap);
+    }
+    Value(Value&& o) noexcept : type(o.type), bits(o.bits) {
+        o.type = Type::Nil;
+    }
+    Value& operator=(const Value& o) {
+        if (o.isHeap()) retainHeap(o.heap);
+        if (isHeap()) releaseHeap(heap);
+        type = o.type;
+        bits = o.bits;
+        return *this;
+    }
+    Value& operator=(Value&& o) noexcept {
+        if (this == &o) return *this;
+        if (isHeap()) releaseHeap(heap);
+        type = o.type;
+        bits = o.bits;
+        o.type = Type::Nil;
+        return *this;
+    }
+    ~Value() {
+        if (isHeap()) releaseHeap(heap);
+    }
+
+    bool isHeap() const { return type >= Type::String; }
+    bool isNil() const { return type == Type::Nil; }
+    bool isInt() const { return type == Type::Int; }
+    bool isDouble() const { return type == Type::Double; }
+    bool isNumber() const { return type == Type::Int || type == Type::Double; }
+    bool isString() const { return type == Type::String; }
+    bool isChar() const { return type == Type::Char; }
+    bool isBool() const { return type == Type::Bool; }
+    bool isList() const { return type == Type::List; }
+    bool isDict() const { return type == Type::Dict; }
+    bool isClass() const { return type == Type::Class; }
+    bool isInstance() const { return type == Type::Instance; }
+
+    int asInt() const { return i; }
+    double asDouble() const { return d; }
+    double toDouble() const { return type == Type::Int ? (double)i : d; }
+    char asChar() const { return c; }
+    bool asBool() const { return b; }
+    const std::string& asString() const;
+    List* asList() const;     // range lazy dibuat jadi list biasa dulu
+    List* asLazyList() const; // tanpa materialize: pakai length() / at()
+    Dict* asDict() const;
+    LinkClass* asClass() const;
+    LinkInstance* asInstance() const;
+
+    bool sameString(const Value& o) const;
 };
 
+static_assert(sizeof(Value) == 16, "Value harus 16 byte");
+
 using Obj = Value;
 
-struct LinkClass {
+// Immutable: string baru selalu objek baru, jadi satu LinkString aman dibagi banyak Value
+struct LinkString : HeapObject {
+    const std::string value;
+    bool interned = false; // ada di tabel Intern
+    explicit LinkString(std::string v) : HeapObject(Type::String), value(std::move(v)) {}
+    LINK_SLAB_ALLOCATED(strings)
+};
+
+struct List : HeapObject, std::vector<Value> {
+    // Hasil range(): elemen dihitung dari start/step, vector baru diisi kalau dipakai sebagai list biasa
+    bool lazy = false;
+    int start = 0, step = 1, count = 0;
+
+    List() : HeapObject(Type::List) {}
+    template <typename It>
+    List(It first, It last) : HeapObject(Type::List), std::vector<Value>(first, last) {}
+    LINK_SLAB_ALLOCATED(lists)
+
+    static List* range(int start, int step, int count) {
+        List* list = new List();
+        list->lazy = true;
+        list->start = start;
+        list->step = step;
+        list->count = count;
+        return list;
+    }
+
+    size_t length() const { return lazy ? (size_t)count : size(); }
+    Value at(size_t i) const { return lazy ? Value(start + (int)i * step) : (*this)[i]; }
+
+    void materialize() {
+        if (!lazy) return;
+        reserve(count);
+        for (int i = 0; i < count; ++i) emplace_back(start + i * step);
+        lazy = false;
+    }
+};
+
+struct Dict : HeapObject, std::unordered_map<std::string, Value> {
+    Dict() : HeapObject(Type::Dict) {}
+    LINK_SLAB_ALLOCATED(dicts)
+};
+
+struct LinkClass : HeapObject {
     std::string name;
-    std::unordered_map<std::string, Stmt*> methods; 
+    const ClassDecl* decl = nullptr; // identitas stabil untuk inline cache (pointer LinkClass bisa dipakai ulang)
+    std::unordered_map<std::string, FuncDecl*> methods;
+    FuncDecl* init = nullptr;
+    LinkClass() : HeapObject(Type::Class) {}
 };
 
-struct LinkInstance {
-    std::shared_ptr<LinkClass> klass;      
-    std::unordered_map<std::string, Value> fields; 
-    };
+// Hidden class: instance yang field-nya ditambahkan dengan urutan sama berbagi Shape,
+// jadi nilai field cukup disimpan di vector dan dicari lewat index.
+// Shape tidak pernah dihapus (dimiliki pohon transisi), aman dipakai sebagai key cache.
+struct Shape {
+    std::vector<const LinkString*> names; // nama field (intern) sesuai index slot
+    std::unordered_map<const LinkString*, std::unique_ptr<Shape>> transitions;
+
+    int find(const LinkString* name) const {
+        for (size_t i = 0; i < names.size(); ++i) {
+            if (names[i] == name) return (int)i;
+        }
+        return -1;
+    }
+
+    Shape* withField(const LinkString* name) {
+        auto& next = transitions[name];
+        if (!next) {
+            next = std::make_unique<Shape>();
+            next->names = names;
+            next->names.push_back(name);
+        }
+        return next.get();
+    }
+
+    static Shape* root() {
+        static Shape empty;
+        return &empty;
+    }
+};
+
+// Pointer ber-refcount untuk objek heap yang dipegang di luar Value
+template <typename T>
+class Ref {
+public:
+    Ref(T* p = nullptr) : ptr(p) { if (ptr) retainHeap(ptr); }
+    Ref(const Ref& o) : Ref(o.ptr) {}
+    Ref(Ref&& o) noexcept : ptr(o.ptr) { o.ptr = nullptr; }
+    Ref& operator=(Ref o) noexcept { std::swap(ptr, o.ptr); return *this; }
+    ~Ref() { if (ptr) releaseHeap(ptr); }
+
+    T* get() const { return ptr; }
+    T* operator->() const { return ptr; }
+    T& operator*() const { return *ptr; }
+    explicit operator bool() const { return ptr != nullptr; }
+
+private:
+    T* ptr;
+};
+
+template <typename T, typename... Args>
+Ref<T> makeRef(Args&&... args) { return Ref<T>(new T(std::forward<Args>(args)...)); }
+
+struct LinkInstance : HeapObject {
+    Ref<LinkClass> klass;
+    Shape* shape = Shape::root();
+    std::vector<Value> fields; // fields[i] milik shape->names[i]
+    LinkInstance() : HeapObject(Type::Instance) {}
+    LINK_SLAB_ALLOCATED(instances)
+};
+
+inline Value::Value(const std::string& v) : type(Type::String) { heap = new LinkString(v); retainHeap(heap); }
+inline Value::Value(std::string&& v) : type(Type::String) { heap = new LinkString(std::move(v)); retainHeap(heap); }
+inline Value::Value(const char* v) : Value(std::string(v)) {}
+inline Value::Value(List* v) : type(Type::List) { heap = v; retainHeap(heap); }
+inline Value::Value(Dict* v) : type(Type::Dict) { heap = v; retainHeap(heap); }
+inline Value::Value(LinkClass* v) : type(Type::Class) { heap = v; retainHeap(heap); }
+inline Value::Value(LinkInstance* v) : type(Type::Instance) { heap = v; retainHeap(heap); }
+
+inline const std::string& Value::asString() const { return static_cast<LinkString*>(heap)->value; }
+// Dua string intern yang berbeda pointer pasti berbeda isi
+inline bool Value::sameString(const Value& o) const {
+    if (heap == o.heap) return true;
+    auto a = static_cast<LinkString*>(heap), b = static_cast<LinkString*>(o.heap);
+    if (a->interned && b->interned) return false;
+    return a->value == b->value;
+}
+
+inline List* Value::asList() const {
+    List* list = static_cast<List*>(heap);
+    if (list->lazy) list->materialize();
+    return list;
+}
+inline List* Value::asLazyList() const { return static_cast<List*>(heap); }
+inline Dict* Value::asDict() const { return static_cast<Dict*>(heap); }
+inline LinkClass* Value::asClass() const { return static_cast<LinkClass*>(heap); }
+inline LinkInstance* Value::asInstance() const { return static_cast<LinkInstance*>(heap); }
+
+inline void releaseHeap(HeapObject* o) {
+    if (--o->refs != 0) {
+        if (!o->gcBuffered && isContainerType(o->type)) Gc::possibleRoot(o);
+        return;
+    }
+    if (o->gcBuffered) {
+        Gc::releaseBuffered(o);
+        return;
+    }
+    switch (o->type) {
+        case Type::String: delete static_cast<LinkString*>(o); break;
+        case Type::List: delete static_cast<List*>(o); break;
+        case Type::Dict: delete static_cast<Dict*>(o); break;
+        case Type::Class: delete static_cast<LinkClass*>(o); break;
+        case Type::Instance: delete static_cast<LinkInstance*>(o); break;
+        default: break;
+    }
+}
 
 inline void printObj(const Obj& val) {
-    if (std::holds_alternative<int>(val.as)) std::cout << std::get<int>(val.as);
-    else if (std::holds_alternative<double>(val.as)) std::cout << std::get<double>(val.as);
-    else if (std::holds_alternative<std::string>(val.as)) std::cout << Sys::unescape(std::get<std::string>(val.as));
-    else if (std::holds_alternative<char>(val.as)) std::cout << std::get<char>(val.as);
-    else if (std::holds_alternative<bool>(val.as)) std::cout << (std::get<bool>(val.as) ? "true" : "false");
-    else if (std::holds_alternative<std::shared_ptr<List>>(val.as)) {
-        auto list = std::get<std::shared_ptr<List>>(val.as);
+    if (val.isInt()) std::cout << val.asInt();
+    else if (val.isDouble()) std::cout << val.asDouble();
+    else if (val.isString()) std::cout << Sys::unescape(val.asString());
+    else if (val.isChar()) std::cout << val.asChar();
+    else if (val.isBool()) std::cout << (val.asBool() ? "true" : "false");
+    else if (val.isList()) {
+        List* list = val.asLazyList();
+        size_t n = list->length();
         std::cout << "[";
-        for (size_t i = 0; i < list->size(); ++i) {
-            printObj((*list)[i]);
-            if (i < list->size() - 1) std::cout << ", ";
+        for (size_t i = 0; i < n; ++i) {
+            printObj(list->at(i));
+            if (i < n - 1) std::cout << ", ";
         }
         std::cout << "]";
     }
-    else if (std::holds_alternative<std::shared_ptr<Dict>>(val.as)) {
-        auto dict = std::get<std::shared_ptr<Dict>>(val.as);
+    else if (val.isDict()) {
+        Dict* dict = val.asDict();
         std::cout << "{";
         int i = 0;
         for (const auto& pair : *dict) {
@@ -85,22 +318,15 @@ inline void printObj(const Obj& val) {
         }
         std::cout << "}";
     }
-    else if (std::holds_alternative<std::shared_ptr<LinkClass>>(val.as)) {
-        std::cout << "<Class " << std::get<std::shared_ptr<LinkClass>>(val.as)->name << ">";
+    else if (val.isClass()) {
+        std::cout << "<Class " << val.asClass()->name << ">";
     }
-    else if (std::holds_alternative<std::shared_ptr<LinkInstance>>(val.as)) {
-        auto instance = std::get<std::shared_ptr<LinkInstance>>(val.as);
-        std::cout << "<Instance " << instance->klass->name << ">";
+    else if (val.isInstance()) {
+        std::cout << "<Instance " << val.asInstance()->klass->name << ">";
     }
     else std::cout << "nil";
 }
 
-struct ReturnException {
-	Obj value; 
-	ReturnException(Obj v) : value(v) {}
-};
-
-struct RuntimeException {
-    std::string message;
-    RuntimeException(std::string msg) : message(msg) {}
-};
+// Hasil eksekusi statement. Return / error dirambatkan lewat nilai ini, bukan exception C++;
+// nilai return & pesan error disimpan di Runtime.
+enum class Completion { Normal, Return, Error, TailCall };
@@ -0,0 +1,43 @@
+#include "arena.h"
+#include <algorithm>
+#include <new>
+
+namespace {
+    thread_local Arena* currentArena = nullptr; // per thread: prefetch mem-parse beberapa Program sekaligus
+
+    Arena& looseArena() {
+        static Arena* arena = new Arena(); // sengaja tidak pernah dihapus
+        return *arena;
+    }
+}
+
+Arena::~Arena() {
+    while (chunkList) {
+        void* previous = *static_cast<void**>(chunkList);
+        ::operator delete(chunkList);
+        chunkList = previous;
+    }
+}
+
+void Arena::grow(size_t size) {
+    // Header 16 byte menyimpan link ke chunk sebelumnya; node besar dapat chunk sendiri
+    size_t bytes = std::max(CHUNK_BYTES, size + 16);
+    char* chunk = static_cast<char*>(::operator new(bytes));
+    *reinterpret_cast<void**>(chunk) = chunkList;
+    chunkList = chunk;
+    chunks++;
+    cursor = chunk + 16;
+    remaining = bytes - 16;
+}
+
+void* Arena::allocateNode(size_t size) {
+    return (currentArena ? currentArena : &looseArena())->allocate(size);
+}
+
+Arena::Scope::Scope(Arena& arena) : previous(currentArena) {
+    currentArena = &arena;
+}
+
+Arena::Scope::~Scope() {
+    currentArena = previous;
+}
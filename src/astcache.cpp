@@ -0,0 +1,495 @@
+#include "astcache.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include "lexer.h"
+#include "parser.h"
+#include "optimizer.h"
+#include "os.h"
+
+namespace AstCache {
+
+    static bool enabled = true;
+
+    void setEnabled(bool on) { enabled = on; }
+
+    // Format: header, tabel string, lalu node preorder (tag 1 byte + field).
+    // Angka pakai varint (signed: zigzag), jadi node kecil umumnya cuma beberapa byte.
+    static const char MAGIC[8] = {'L', 'I', 'N', 'K', 'A', 'S', 'T', '\0'};
+
+    enum class Tag : uint8_t {
+        Null,
+        // Expr
+        Input, Number, Float, String, Char, Bool, Variable, Call, MethodCall, This,
+        Get, Set, Array, Dict, Index, Binary, New,
+        // Stmt
+        Clear, SetStmt, While, If, For, Func, Class, CallStmt, Update, Property,
+        App, Window, Connect, Return, Import, Try, ExprStmt
+    };
+
+    struct Corrupt : std::runtime_error {
+        Corrupt() : std::runtime_error("corrupt AST cache") {}
+    };
+
+    // Hash isi file: 8 byte per langkah (FNV-1a per word + mix akhir)
+    uint64_t contentHash(std::string_view data) {
+        uint64_t h = 0xcbf29ce484222325ULL;
+        size_t i = 0;
+        for (; i + 8 <= data.size(); i += 8) {
+            uint64_t word;
+            std::memcpy(&word, data.data() + i, 8);
+            h = (h ^ word) * 0x100000001b3ULL;
+            h ^= h >> 29;
+        }
+        for (; i < data.size(); i++) h = (h ^ (unsigned char)data[i]) * 0x100000001b3ULL;
+        return h ^ (h >> 32) ^ data.size();
+    }
+
+    class Writer {
+    public:
+        std::string body;
+        std::vector<const std::string*> strings;
+
+        void byte(uint8_t b) { body.push_back(static_cast<char>(b)); }
+        void tag(Tag t) { byte(static_cast<uint8_t>(t)); }
+        void varint(uint64_t v) {
+            while (v >= 0x80) { byte(static_cast<uint8_t>(v | 0x80)); v >>= 7; }
+            byte(static_cast<uint8_t>(v));
+        }
+        void integer(int64_t v) { varint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63)); }
+        void real(double v) {
+            char bytes[8];
+            std::memcpy(bytes, &v, 8);
+            body.append(bytes, 8);
+        }
+        void text(const std::string& s) {
+            auto it = index.find(s);
+            if (it == index.end()) {
+                it = index.emplace(s, static_cast<uint32_t>(strings.size())).first;
+                strings.push_back(&it->first);
+            }
+            varint(it->second);
+        }
+
+        void expr(const Expr* e);
+        void exprs(const std::vector<std::unique_ptr<Expr>>& list);
+        void stmt(const Stmt* s);
+        void block(const std::vector<std::unique_ptr<Stmt>>& body);
+        void func(const FuncDecl* fn);
+
+    private:
+        std::unordered_map<std::string, uint32_t> index;
+    };
+
+    void Writer::exprs(const std::vector<std::unique_ptr<Expr>>& list) {
+        varint(list.size());
+        for (auto& e : list) expr(e.get());
+    }
+
+    void Writer::block(const std::vector<std::unique_ptr<Stmt>>& list) {
+        varint(list.size());
+        for (auto& s : list) stmt(s.get());
+    }
+
+    void Writer::func(const FuncDecl* fn) {
+        text(fn->name);
+        varint(fn->params.size());
+        for (auto& param : fn->params) text(param);
+        byte(fn->memo ? 1 : 0);
+        block(fn->body);
+    }
+
+    void Writer::expr(const Expr* e) {
+        if (!e) { tag(Tag::Null); return; }
+        if (auto n = dynamic_cast<const NumberExpr*>(e)) { tag(Tag::Number); integer(n->value); }
+        else if (auto f = dynamic_cast<const FloatExpr*>(e)) { tag(Tag::Float); real(f->value); }
+        else if (auto s = dynamic_cast<const StringExpr*>(e)) { tag(Tag::String); text(s->value); }
+        else if (auto v = dynamic_cast<const VariableExpr*>(e)) { tag(Tag::Variable); text(v->name); }
+        else if (auto b = dynamic_cast<const BinaryExpr*>(e)) { tag(Tag::Binary); byte(static_cast<uint8_t>(b->op)); expr(b->lhs.get()); expr(b->rhs.get()); }
+        else if (auto c = dynamic_cast<const CallExpr*>(e)) { tag(Tag::Call); text(c->func); exprs(c->args); }
+        else if (auto m = dynamic_cast<const MethodCallExpr*>(e)) { tag(Tag::MethodCall); expr(m->object.get()); text(m->method); exprs(m->args); }
+        else if (auto g = dynamic_cast<const GetExpr*>(e)) { tag(Tag::Get); expr(g->object.get()); text(g->name); }
+        else if (auto st = dynamic_cast<const SetExpr*>(e)) { tag(Tag::Set); expr(st->object.get()); text(st->name); expr(st->value.get()); }
+        else if (auto a = dynamic_cast<const ArrayExpr*>(e)) { tag(Tag::Array); exprs(a->elements); }
+        else if (auto d = dynamic_cast<const DictExpr*>(e)) {
+            tag(Tag::Dict);
+            varint(d->pairs.size());
+            for (auto& pair : d->pairs) { expr(pair.first.get()); expr(pair.second.get()); }
+        }
+        else if (auto i = dynamic_cast<const IndexExpr*>(e)) { tag(Tag::Index); expr(i->object.get()); expr(i->index.get()); }
+        else if (auto nw = dynamic_cast<const NewExpr*>(e)) { tag(Tag::New); text(nw->className); exprs(nw->args); }
+        else if (auto ch = dynamic_cast<const CharExpr*>(e)) { tag(Tag::Char); byte(static_cast<uint8_t>(ch->value)); }
+        else if (auto bo = dynamic_cast<const BoolExpr*>(e)) { tag(Tag::Bool); byte(bo->value ? 1 : 0); }
+        else if (dynamic_cast<const ThisExpr*>(e)) tag(Tag::This);
+        else if (auto in = dynamic_cast<const InputExpr*>(e)) { tag(Tag::Input); text(in->prompt); }
+        else throw std::logic_error("AstCache: unknown Expr");
+    }
+
+    void Writer::stmt(const Stmt* s) {
+        if (!s) { tag(Tag::Null); return; }
+        if (auto set = dynamic_cast<const SetStmt*>(s)) { tag(Tag::SetStmt); text(set->name); expr(set->expression.get()); }
+        else if (auto call = dynamic_cast<const CallStmt*>(s)) { tag(Tag::CallStmt); text(call->func); exprs(call->args); }
+        else if (auto e = dynamic_cast<const ExprStmt*>(s)) { tag(Tag::ExprStmt); expr(e->expression.get()); }
+        else if (auto ifStmt = dynamic_cast<const IfStmt*>(s)) { tag(Tag::If); expr(ifStmt->condition.get()); block(ifStmt->thenBranch); block(ifStmt->elseBranch); }
+        else if (auto loop = dynamic_cast<const WhileStmt*>(s)) { tag(Tag::While); expr(loop->condition.get()); block(loop->body); }
+        else if (auto loop = dynamic_cast<const ForStmt*>(s)) { tag(Tag::For); text(loop->iteratorName); expr(loop->collection.get()); block(loop->body); }
+        else if (auto ret = dynamic_cast<const ReturnStmt*>(s)) { tag(Tag::Return); expr(ret->value.get()); }
+        else if (auto up = dynamic_cast<const UpdateStmt*>(s)) { tag(Tag::Update); text(up->name); text(up->op); }
+        else if (auto fn = dynamic_cast<const FuncDecl*>(s)) { tag(Tag::Func); func(fn); }
+        else if (auto cls = dynamic_cast<const ClassDecl*>(s)) {
+            tag(Tag::Class);
+            text(cls->name);
+            varint(cls->methods.size());
+            for (auto& method : cls->methods) func(method.get());
+        }
+        else if (auto t = dynamic_cast<const TryStmt*>(s)) { tag(Tag::Try); block(t->tryBody); block(t->catchBody); text(t->errorVar); }
+        else if (auto imp = dynamic_cast<const ImportStmt*>(s)) { tag(Tag::Import); text(imp->path); byte(imp->lazy ? 1 : 0); }
+        else if (auto prop = dynamic_cast<const PropertyStmt*>(s)) { tag(Tag::Property); text(prop->name); text(prop->value); }
+        else if (auto app = dynamic_cast<const AppDecl*>(s)) { tag(Tag::App); text(app->name); block(app->body); }
+        else if (auto window = dynamic_cast<const WindowDecl*>(s)) { tag(Tag::Window); text(window->name); block(window->body); }
+        else if (auto conn = dynamic_cast<const ConnectStmt*>(s)) { tag(Tag::Connect); text(conn->source); text(conn->event); text(conn->target); }
+        else if (dynamic_cast<const ClearStmt*>(s)) tag(Tag::Clear);
+        else throw std::logic_error("AstCache: unknown Stmt");
+    }
+
+    class Reader {
+    public:
+        Reader(const char* data, size_t size) : p(reinterpret_cast<const uint8_t*>(data)), end(p + size) {}
+
+        uint8_t byte() { if (p >= end) throw Corrupt(); return *p++; }
+        Tag tag() { uint8_t t = byte(); if (t > static_cast<uint8_t>(Tag::ExprStmt)) throw Corrupt(); return static_cast<Tag>(t); }
+        uint64_t varint() {
+            uint64_t v = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                uint8_t b = byte();
+                v |= static_cast<uint64_t>(b & 0x7F) << shift;
+                if (!(b & 0x80)) return v;
+            }
+            throw Corrupt();
+        }
+        int64_t integer() { uint64_t v = varint(); return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+        double real() { double v; std::memcpy(&v, bytes(8).data(), 8); return v; }
+        std::string_view bytes(size_t n) {
+            if (static_cast<size_t>(end - p) < n) throw Corrupt();
+            std::string_view view(reinterpret_cast<const char*>(p), n);
+            p += n;
+            return view;
+        }
+        size_t count() { uint64_t n = varint(); if (n > static_cast<size_t>(end - p)) throw Corrupt(); return n; } // tiap item >= 1 byte
+
+        void readStrings();
+        const std::string& text() { uint64_t i = varint(); if (i >= strings.size()) throw Corrupt(); return strings[i]; }
+        Name name() {
+            uint64_t i = varint();
+            if (i >= strings.size()) throw Corrupt();
+            if (!names[i].key()) {
+                // Variabel sementara optimizer harus unik di semua Program yang sedang dimuat
+                names[i] = Optimizer::isTemporary(strings[i]) ? Name(Optimizer::temporaryName()) : Name(strings[i]);
+            }
+            return names[i];
+        }
+
+        std::unique_ptr<Expr> expr();
+        std::vector<std::unique_ptr<Expr>> exprs();
+        std::unique_ptr<Stmt> stmt();
+        std::vector<std::unique_ptr<Stmt>> block();
+        std::unique_ptr<FuncDecl> func();
+
+    private:
+        const uint8_t* p;
+        const uint8_t* end;
+        std::vector<std::string> strings;
+        std::vector<Name> names;
+    };
+
+    void Reader::readStrings() {
+        size_t n = count();
+        strings.reserve(n);
+        for (size_t i = 0; i < n; i++) strings.emplace_back(bytes(varint()));
+        names.resize(n);
+    }
+
+    std::vector<std::unique_ptr<Expr>> Reader::exprs() {
+        std::vector<std::unique_ptr<Expr>> list(count());
+        for (auto& e : list) e = expr();
+        return list;
+    }
+
+    std::vector<std::unique_ptr<Stmt>> Reader::block() {
+        std::vector<std::unique_ptr<Stmt>> list(count());
+        for (auto& s : list) s = stmt();
+        return list;
+    }
+
+    std::unique_ptr<FuncDecl> Reader::func() {
+        Name fnName = name();
+        std::vector<Name> params(count());
+        for (auto& param : params) param = name();
+        auto fn = std::make_unique<FuncDecl>(fnName, std::move(params));
+        fn->memo = byte() != 0;
+        fn->body = block();
+        return fn;
+    }
+
+    std::unique_ptr<Expr> Reader::expr() {
+        switch (tag()) {
+            case Tag::Null: return nullptr;
+            case Tag::Number: return std::make_unique<NumberExpr>(static_cast<int>(integer()));
+            case Tag::Float: return std::make_unique<FloatExpr>(real());
+            case Tag::String: return std::make_unique<StringExpr>(text());
+            case Tag::Variable: return std::make_unique<VariableExpr>(name());
+            case Tag::Binary: {
+                char op = static_cast<char>(byte());
+                auto lhs = expr();
+                auto rhs = expr();
+                return std::make_unique<BinaryExpr>(op, std::move(lhs), std::move(rhs));
+            }
+            case Tag::Call: {
+                Name fn = name();
+                return std::make_unique<CallExpr>(fn, exprs());
+            }
+            case Tag::MethodCall: {
+                auto object = expr();
+                Name method = name();
+                return std::make_unique<MethodCallExpr>(std::move(object), method, exprs());
+            }
+            case Tag::Get: {
+                auto object = expr();
+                return std::make_unique<GetExpr>(std::move(object), name());
+            }
+            case Tag::Set: {
+                auto object = expr();
+                Name field = name();
+                return std::make_unique<SetExpr>(std::move(object), field, expr());
+            }
+            case Tag::Array: return std::make_unique<ArrayExpr>(exprs());
+            case Tag::Dict: {
+                std::vector<std::pair<std::unique_ptr<Expr>, std::unique_ptr<Expr>>> pairs(count());
+                for (auto& pair : pairs) {
+                    pair.first = expr();
+                    pair.second = expr();
+                }
+                return std::make_unique<DictExpr>(std::move(pairs));
+            }
+            case Tag::Index: {
+                auto object = expr();
+                return std::make_unique<IndexExpr>(std::move(object), expr());
+            }
+            case Tag::New: {
+                Name className = name();
+                return std::make_unique<NewExpr>(className, exprs());
+            }
+            case Tag::Char: return std::make_unique<CharExpr>(static_cast<char>(byte()));
+            case Tag::Bool: return std::make_unique<BoolExpr>(byte() != 0);
+            case Tag::This: {
+                Token keyword{};
+                keyword.type = TokenType::THIS;
+                return std::make_unique<ThisExpr>(keyword);
+            }
+            case Tag::Input: return std::make_unique<InputExpr>(text());
+            default: throw Corrupt();
+        }
+    }
+
+    std::unique_ptr<Stmt> Reader::stmt() {
+        switch (tag()) {
+            case Tag::Null: return nullptr;
+            case Tag::SetStmt: {
+                Name var = name();
+                return std::make_unique<SetStmt>(var, expr());
+            }
+            case Tag::CallStmt: {
+                Name fn = name();
+                return std::make_unique<CallStmt>(fn, exprs());
+            }
+            case Tag::ExprStmt: return std::make_unique<ExprStmt>(expr());
+            case Tag::If: {
+                auto ifStmt = std::make_unique<IfStmt>(expr());
+                ifStmt->thenBranch = block();
+                ifStmt->elseBranch = block();
+                return ifStmt;
+            }
+            case Tag::While: {
+                auto loop = std::make_unique<WhileStmt>(expr());
+                loop->body = block();
+                return loop;
+            }
+            case Tag::For: {
+                Name iterator = name();
+                auto loop = std::make_unique<ForStmt>(iterator, expr());
+                loop->body = block();
+                return loop;
+            }
+            case Tag::Return: return std::make_unique<ReturnStmt>(expr());
+            case Tag::Update: {
+                Name var = name();
+                return std::make_unique<UpdateStmt>(var, text());
+            }
+            case Tag::Func: return func();
+            case Tag::Class: {
+                Name className = name();
+                std::vector<std::unique_ptr<FuncDecl>> methods(count());
+                for (auto& method : methods) method = func();
+                return std::make_unique<ClassDecl>(className, std::move(methods));
+            }
+            case Tag::Try: {
+                auto tryBody = block();
+                auto catchBody = block();
+                return std::make_unique<TryStmt>(std::move(tryBody), std::move(catchBody), name());
+            }
+            case Tag::Import: {
+                auto imp = std::make_unique<ImportStmt>(text());
+                imp->lazy = byte() != 0;
+                return imp;
+            }
+            case Tag::Property: {
+                std::string key = text();
+                return std::make_unique<PropertyStmt>(key, text());
+            }
+            case Tag::App: {
+                auto app = std::make_unique<AppDecl>(text());
+                app->body = block();
+                return app;
+            }
+            case Tag::Window: {
+                auto window = std::make_unique<WindowDecl>(text());
+                window->body = block();
+                return window;
+            }
+            case Tag::Connect: {
+                std::string source = text();
+                std::string event = text();
+                return std::make_unique<ConnectStmt>(source, event, text());
+            }
+            case Tag::Clear: return std::make_unique<ClearStmt>();
+            default: throw Corrupt();
+        }
+    }
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t pathLength;
+        uint64_t size;
+        int64_t mtime;
+        uint64_t hash;
+        uint64_t payloadHash; // hash path + tabel string + node: file cache rusak tidak dipakai
+    };
+
+    static Header headerFor(const std::string& sourcePath, std::string_view source) {
+        Header header;
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = FORMAT_VERSION;
+        header.pathLength = static_cast<uint32_t>(sourcePath.size());
+        header.size = source.size();
+        header.mtime = Sys::fileTime(sourcePath);
+        header.hash = contentHash(source);
+        header.payloadHash = 0;
+        return header;
+    }
+
+    std::string cachePath(const std::string& sourcePath) {
+        size_t slash = sourcePath.find_last_of("/\\");
+        std::string dir = slash == std::string::npos ? "" : sourcePath.substr(0, slash + 1);
+        std::string file = slash == std::string::npos ? sourcePath : sourcePath.substr(slash + 1);
+        return dir + "__linkcache__/" + file + ".astc";
+    }
+
+    std::unique_ptr<Program> load(const std::string& sourcePath, std::string_view source) {
+        if (!enabled || sourcePath.empty()) return nullptr;
+        Sys::MappedFile file(cachePath(sourcePath));
+        std::string_view data = file.text();
+        if (!file.isOpen() || data.size() < sizeof(Header)) return nullptr;
+
+        Header expected = headerFor(sourcePath, source);
+        Header stored;
+        std::memcpy(&stored, data.data(), sizeof(Header));
+        if (std::memcmp(stored.magic, expected.magic, sizeof(MAGIC)) != 0 || stored.version != expected.version ||
+            stored.size != expected.size || stored.mtime != expected.mtime || stored.hash != expected.hash ||
+            stored.pathLength != expected.pathLength ||
+            data.substr(sizeof(Header), stored.pathLength) != sourcePath ||
+            stored.payloadHash != contentHash(data.substr(sizeof(Header)))) {
+            return nullptr;
+        }
+
+        return decode(data.substr(sizeof(Header) + stored.pathLength));
+    }
+
+    std::string encode(const Program& program) {
+        Writer writer;
+        writer.block(program.statements);
+
+        Writer table;
+        table.varint(writer.strings.size());
+        for (const std::string* s : writer.strings) {
+            table.varint(s->size());
+            table.body += *s;
+        }
+        return table.body + writer.body;
+    }
+
+    std::unique_ptr<Program> decode(std::string_view data) {
+        Reader reader(data.data(), data.size());
+        auto program = std::make_unique<Program>();
+        try {
+            Arena::Scope scope(program->arena);
+            reader.readStrings();
+            program->statements = reader.block();
+        } catch (const Corrupt&) {
+            return nullptr;
+        }
+        return program;
+    }
+
+    bool store(const std::string& sourcePath, std::string_view source, const Program& program) {
+        if (!enabled || sourcePath.empty()) return false;
+        std::string path = cachePath(sourcePath);
+        Sys::makeDir(path.substr(0, path.find_last_of('/')));
+        Header header = headerFor(sourcePath, source);
+        std::string payload = sourcePath + encode(program);
+        header.payloadHash = contentHash(payload);
+
+        // Tulis ke file sementara lalu rename: proses lain tidak pernah membaca cache setengah jadi
+        std::string temp = path + ".tmp" + std::to_string(Sys::processId());
+        {
+            std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+            if (!out) return false;
+            out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+            out << payload;
+            if (!out) { out.close(); std::remove(temp.c_str()); return false; }
+        }
+        if (std::rename(temp.c_str(), path.c_str()) != 0) {
+            std::remove(path.c_str());
+            if (std::rename(temp.c_str(), path.c_str()) != 0) {
+                std::remove(temp.c_str());
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::unique_ptr<Program> parse(const std::string& sourcePath, std::string_view source, bool& cached) {
+        auto program = load(sourcePath, source);
+        cached = program != nullptr;
+        if (cached) return program;
+
+        Lexer lexer(source);
+        Parser parser(lexer.tokenize(), source);
+        return parser.parse();
+    }
+
+    void finish(const std::string& sourcePath, std::string_view source, Program& program) {
+        Optimizer().optimize(program);
+        store(sourcePath, source, program);
+    }
+
+    std::unique_ptr<Program> compile(const std::string& sourcePath, std::string_view source) {
+        bool cached;
+        auto program = parse(sourcePath, source, cached);
+        if (!cached) finish(sourcePath, source, *program);
+        return program;
+    }
+}
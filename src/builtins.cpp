@@ -0,0 +1,315 @@
+#include "builtins.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <unordered_map>
+#include "os.h"
+#include "link_str.h"
+#include "link_math.h"
+#include "memo.h"
+#include "gc.h"
+#include "slab.h"
+
+namespace Builtins {
+
+    static bool errorRaised = false;
+    static std::string errorMessage;
+
+    void raise(const std::string& message) {
+        errorRaised = true;
+        errorMessage = message;
+    }
+
+    bool takeError(std::string& message) {
+        if (!errorRaised) return false;
+        errorRaised = false;
+        message = std::move(errorMessage);
+        return true;
+    }
+
+    bool rangeBounds(const Obj* args, int argc, int& start, int& step, int& count) {
+        if (argc < 1) return false;
+        auto arg = [&](int i, int fallback) { return i < argc ? (args[i].isInt() ? args[i].asInt() : 0) : fallback; };
+        start = argc >= 2 ? arg(0, 0) : 0;
+        int stop = argc >= 2 ? arg(1, 0) : arg(0, 0);
+        step = arg(2, 1);
+        long long span = (long long)stop - start;
+        if (step > 0 && span > 0) count = (int)((span + step - 1) / step);
+        else if (step < 0 && span < 0) count = (int)((-span + (-(long long)step) - 1) / -(long long)step);
+        else count = 0;
+        return true;
+    }
+
+    static bool isString(const Obj& o) { return o.isString(); }
+    static const std::string& asString(const Obj& o) { return o.asString(); }
+
+    static double toDouble(Obj* args, int argc, int i) {
+        if (i >= argc) return 0.0;
+        if (args[i].isDouble()) return args[i].asDouble();
+        if (args[i].isInt()) return (double)args[i].asInt();
+        return 0.0;
+    }
+
+    static std::string toText(const Obj& o) {
+        if (isString(o)) return asString(o);
+        if (o.isInt()) return std::to_string(o.asInt());
+        if (o.isDouble()) return std::to_string(o.asDouble());
+        return "";
+    }
+
+    // --- TIME & SYSTEM ---
+    static Obj timeSleep(Obj* args, int argc) {
+        if (argc < 1) return Obj();
+        int ms = 0;
+        if (args[0].isInt()) ms = args[0].asInt();
+        else if (args[0].isDouble()) ms = (int)args[0].asDouble();
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+        return Obj();
+    }
+
+    // sys.memoSize() = batas cache memo sekarang, sys.memoSize(n) = ganti batas (hasilnya batas lama)
+    static Obj sysMemoSize(Obj* args, int argc) {
+        int previous = (int)Memo::capacity();
+        if (argc >= 1 && args[0].isInt()) Memo::setCapacity((size_t)std::max(0, args[0].asInt()));
+        return Obj(previous);
+    }
+
+    static Obj sysMemoClear(Obj*, int) {
+        Memo::clear();
+        return Obj();
+    }
+
+    // Jalankan cycle collector sekarang; hasilnya perkiraan byte yang dibebaskan
+    static Obj sysGc(Obj*, int) {
+        return Obj((int)Gc::collect());
+    }
+
+    // Statistik pool slab per jenis objek: {"list": {"live": .., "peak": .., ...}, ...}
+    static Obj sysHeapStats(Obj*, int) {
+        auto result = makeRef<Dict>();
+        for (size_t i = 0; i < Slab::count(); ++i) {
+            Slab::Stats stats = Slab::stats(i);
+            auto pool = makeRef<Dict>();
+            (*pool)["size"] = Obj((int)stats.objectSize);
+            (*pool)["live"] = Obj((int)stats.live);
+            (*pool)["peak"] = Obj((int)stats.peak);
+            (*pool)["allocs"] = Obj((int)stats.allocs);
+            (*pool)["slabs"] = Obj((int)stats.slabs);
+            (*pool)["bytes"] = Obj((int)stats.bytes);
+            (*result)[stats.name] = Obj(pool);
+        }
+        return Obj(result);
+    }
+
+    static Obj osExec(Obj* args, int argc) {
+        if (argc < 1) return Obj("");
+        if (isString(args[0])) return Obj(Sys::exec(asString(args[0]).c_str()));
+        return Obj("");
+    }
+
+    // Sebagai statement output langsung ke terminal (tidak ditangkap)
+    static Obj osExecStmt(Obj* args, int argc) {
+        if (argc >= 1 && isString(args[0])) {
+            int status = system(asString(args[0]).c_str()); (void)status;
+        }
+        return Obj();
+    }
+
+    static Obj osGetenv(Obj* args, int argc) {
+        if (argc < 1) return Obj("");
+        if (isString(args[0])) return Obj(Sys::getEnv(asString(args[0])));
+        return Obj("");
+    }
+
+    static Obj osSetenv(Obj* args, int argc) {
+        if (argc < 2) return Obj();
+        if (isString(args[0]) && isString(args[1])) Sys::setEnv(asString(args[0]), asString(args[1]));
+        return Obj();
+    }
+
+    static Obj print(Obj* args, int argc) {
+        if (argc >= 1) printObj(args[0]);
+        std::cout << "\n";
+        return Obj();
+    }
+
+    // --- LIST & DATA ---
+    // List lazy: elemen baru dibuat kalau list-nya diubah / dipakai sebagai list biasa
+    static Obj range(Obj* args, int argc) {
+        int start, step, count;
+        if (!rangeBounds(args, argc, start, step, count)) return Obj();
+        return Obj(List::range(start, step, count));
+    }
+
+    static Obj len(Obj* args, int argc) {
+        if (argc < 1) return Obj(0);
+        if (isString(args[0])) return Obj((int)asString(args[0]).length());
+        if (args[0].isList()) return Obj((int)args[0].asLazyList()->length());
+        return Obj(0);
+    }
+
+    static Obj listAdd(Obj* args, int argc) {
+        if (argc < 2) return Obj();
+        if (args[0].isList()) {
+            args[0].asList()->push_back(args[1]);
+        }
+        return Obj();
+    }
+
+    // --- FILE I/O ---
+    // io.read(path) = seluruh isi; io.read(path, offset, length) = potongan saja. File di-mmap,
+    // jadi hanya bagian yang diminta yang dibaca dan disalin sekali (untuk log besar per potong).
+    static Obj ioRead(Obj* args, int argc) {
+        if (argc < 1) return Obj("");
+        if (isString(args[0])) {
+            const std::string& path = asString(args[0]);
+            Sys::MappedFile file(path);
+            if (!file.isOpen()) {
+                raise("File not found: " + path);
+                return Obj("");
+            }
+            std::string_view text = file.text();
+            if (argc >= 2) {
+                double offset = std::max(0.0, toDouble(args, argc, 1));
+                double length = argc >= 3 ? std::max(0.0, toDouble(args, argc, 2)) : (double)text.size();
+                if (offset >= (double)text.size()) return Obj("");
+                text = text.substr((size_t)offset, (size_t)std::min(length, (double)text.size()));
+            }
+            return Obj(std::string(text));
+        }
+        return Obj("");
+    }
+
+    // Ukuran file dalam byte (double kalau lewat batas int), -1 kalau tidak ada
+    static Obj ioSize(Obj* args, int argc) {
+        if (argc < 1 || !isString(args[0])) return Obj(-1);
+        long long size = Sys::fileSize(asString(args[0]));
+        if (size <= std::numeric_limits<int>::max()) return Obj((int)size);
+        return Obj((double)size);
+    }
+
+    static Obj ioWrite(Obj* args, int argc) {
+        if (argc >= 2 && isString(args[0])) Sys::writeFile(asString(args[0]), toText(args[1]), false);
+        return Obj();
+    }
+
+    static Obj ioAppend(Obj* args, int argc) {
+        if (argc >= 2 && isString(args[0])) Sys::writeFile(asString(args[0]), toText(args[1]), true);
+        return Obj();
+    }
+
+    static Obj ioExists(Obj* args, int argc) {
+        if (argc < 1) return Obj(false);
+        if (isString(args[0])) return Obj(Sys::fileExists(asString(args[0])));
+        return Obj(false);
+    }
+
+    static Obj ioRemove(Obj* args, int argc) {
+        if (argc >= 1 && isString(args[0])) Sys::removeFile(asString(args[0]));
+        return Obj();
+    }
+
+    // --- STRING ---
+    static Obj strTrim(Obj* args, int argc) {
+        if (argc < 1) return Obj("");
+        if (isString(args[0])) return Obj(SysString::trim(asString(args[0])));
+        return args[0];
+    }
+
+    static Obj strReplace(Obj* args, int argc) {
+        if (argc < 3) return Obj("");
+        if (isString(args[0]) && isString(args[1]) && isString(args[2]))
+            return Obj(SysString::replace(asString(args[0]), asString(args[1]), asString(args[2])));
+        return args[0];
+    }
+
+    static Obj strSplit(Obj* args, int argc) {
+        auto list = makeRef<List>();
+        if (argc < 2) return Obj(list);
+        if (isString(args[0]) && isString(args[1])) {
+            auto vec = SysString::split(asString(args[0]), asString(args[1]));
+            for (const auto& v : vec) list->push_back(Obj(v));
+        }
+        return Obj(list);
+    }
+
+    static Obj strMerge(Obj* args, int argc) {
+        if (argc < 2) return Obj("");
+        if (args[0].isList() && isString(args[1])) {
+            std::vector<std::string> vs;
+            for (auto& item : *args[0].asList()) {
+                if (isString(item) || item.isInt() || item.isDouble())
+                    vs.push_back(toText(item));
+            }
+            return Obj(SysString::merge(vs, asString(args[1])));
+        }
+        return Obj("");
+    }
+
+    static Obj strContains(Obj* args, int argc) {
+        if (argc < 2) return Obj(false);
+        if (isString(args[0]) && isString(args[1])) return Obj(Sys::contains(asString(args[0]), asString(args[1])));
+        return Obj(false);
+    }
+
+    // --- MATH ---
+    static Obj mathPi(Obj*, int) { return Obj(SysMath::pi()); }
+    static Obj mathSin(Obj* args, int argc) { return Obj(SysMath::sin(toDouble(args, argc, 0))); }
+    static Obj mathCos(Obj* args, int argc) { return Obj(SysMath::cos(toDouble(args, argc, 0))); }
+    static Obj mathTan(Obj* args, int argc) { return Obj(SysMath::tan(toDouble(args, argc, 0))); }
+    static Obj mathSqrt(Obj* args, int argc) { return Obj(SysMath::sqrt(toDouble(args, argc, 0))); }
+    static Obj mathAbs(Obj* args, int argc) { return Obj(SysMath::abs(toDouble(args, argc, 0))); }
+    static Obj mathPow(Obj* args, int argc) {
+        if (argc < 2) return Obj(0.0);
+        return Obj(SysMath::pow(toDouble(args, argc, 0), toDouble(args, argc, 1)));
+    }
+
+    static const Native natives[] = {
+        {"print",        1, print,       nullptr},
+        {"time.sleep",   1, timeSleep,   nullptr},
+        {"sys.memoSize", 1, sysMemoSize, nullptr},
+        {"sys.memoClear",0, sysMemoClear, nullptr},
+        {"sys.gc",       0, sysGc,       nullptr},
+        {"sys.heapStats",0, sysHeapStats, nullptr},
+        {"os.exec",      1, osExec,      osExecStmt},
+        {"os.getenv",    1, osGetenv,    nullptr},
+        {"os.setenv",    2, osSetenv,    nullptr},
+        {"range",        3, range,       nullptr},
+        {"len",          1, len,         nullptr},
+        {"str.len",      1, len,         nullptr},
+        {"list.add",     2, listAdd,     nullptr},
+        {"io.read",      3, ioRead,      nullptr},
+        {"io.size",      1, ioSize,      nullptr},
+        {"io.write",     2, ioWrite,     nullptr},
+        {"io.append",    2, ioAppend,    nullptr},
+        {"io.exists",    1, ioExists,    nullptr},
+        {"io.remove",    1, ioRemove,    nullptr},
+        {"str.trim",     1, strTrim,     nullptr},
+        {"str.replace",  3, strReplace,  nullptr},
+        {"str.split",    2, strSplit,    nullptr},
+        {"str.merge",    2, strMerge,    nullptr},
+        {"str.contains", 2, strContains, nullptr},
+        {"math.pi",      0, mathPi,      nullptr},
+        {"math.sin",     1, mathSin,     nullptr},
+        {"math.cos",     1, mathCos,     nullptr},
+        {"math.tan",     1, mathTan,     nullptr},
+        {"math.sqrt",    1, mathSqrt,    nullptr},
+        {"math.abs",     1, mathAbs,     nullptr},
+        {"math.pow",     2, mathPow,     nullptr},
+    };
+
+    int find(const std::string& name) {
+        static const std::unordered_map<std::string, int> index = [] {
+            std::unordered_map<std::string, int> m;
+            for (size_t i = 0; i < sizeof(natives) / sizeof(natives[0]); ++i) m[natives[i].name] = (int)i;
+            return m;
+        }();
+        auto it = index.find(name);
+        return it == index.end() ? -1 : it->second;
+    }
+
+    const Native& get(int id) { return natives[id]; }
+}
@@ -0,0 +1,343 @@
+#include "bytecode.h"
+#include <algorithm>
+#include "builtins.h"
+
+std::unique_ptr<Chunk> Compiler::compile(const std::vector<std::unique_ptr<Stmt>>& body, bool isFunction) {
+    auto result = std::make_unique<Chunk>();
+    chunk = result.get();
+    compileBlock(body);
+    if (isFunction) {
+        chunk->emit(OpCode::NIL);
+        chunk->emit(OpCode::RETURN);
+    } else {
+        chunk->emit(OpCode::HALT);
+    }
+    chunk = nullptr;
+    return result;
+}
+
+void Compiler::emitRef(const SlotRef& ref) {
+    chunk->emitOperand((uint32_t)ref.local);
+    chunk->emitOperand((uint32_t)ref.global);
+}
+
+uint32_t Compiler::addConstant(Obj value) {
+    chunk->constants.push_back(std::move(value));
+    return (uint32_t)(chunk->constants.size() - 1);
+}
+
+void Compiler::emitFallback(Stmt* stmt) {
+    chunk->stmts.push_back(stmt);
+    chunk->emit(OpCode::EXEC_STMT);
+    chunk->emitOperand((uint32_t)(chunk->stmts.size() - 1));
+}
+
+void Compiler::emitFallback(Expr* expr) {
+    chunk->exprs.push_back(expr);
+    chunk->emit(OpCode::EVAL_EXPR);
+    chunk->emitOperand((uint32_t)(chunk->exprs.size() - 1));
+}
+
+size_t Compiler::emitJump(OpCode op) {
+    chunk->emit(op);
+    size_t at = chunk->code.size();
+    chunk->emitOperand(0);
+    return at;
+}
+
+void Compiler::patchJump(size_t operandAt) {
+    chunk->patchOperand(operandAt, (uint32_t)chunk->code.size());
+}
+
+void Compiler::compileBlock(const std::vector<std::unique_ptr<Stmt>>& body) {
+    for (auto& s : body) compileStmt(s.get());
+}
+
+void Compiler::compileStmt(Stmt* stmt) {
+    if (!stmt) return;
+
+    if (auto exprStmt = dynamic_cast<ExprStmt*>(stmt)) {
+        compileExpr(exprStmt->expression.get());
+        chunk->emit(OpCode::POP);
+        return;
+    }
+
+    if (auto set = dynamic_cast<SetStmt*>(stmt)) {
+        compileExpr(set->expression.get());
+        chunk->emit(OpCode::DEFINE_VAR);
+        emitRef(set->ref);
+        return;
+    }
+
+    if (auto up = dynamic_cast<UpdateStmt*>(stmt)) {
+        chunk->emit(OpCode::INCR_VAR);
+        emitRef(up->ref);
+        return;
+    }
+
+    if (auto call = dynamic_cast<CallStmt*>(stmt)) {
+        compileCall(call->builtin, call->function, call->args, true);
+        chunk->emit(OpCode::POP);
+        return;
+    }
+
+    if (auto ifStmt = dynamic_cast<IfStmt*>(stmt)) {
+        compileExpr(ifStmt->condition.get());
+        size_t elseJump = emitJump(OpCode::JUMP_IF_FALSE);
+        compileBlock(ifStmt->thenBranch);
+        if (ifStmt->elseBranch.empty()) {
+            patchJump(elseJump);
+            return;
+        }
+        size_t endJump = emitJump(OpCode::JUMP);
+        patchJump(elseJump);
+        compileBlock(ifStmt->elseBranch);
+        patchJump(endJump);
+        return;
+    }
+
+    if (auto whileLoop = dynamic_cast<WhileStmt*>(stmt)) {
+        uint32_t start = (uint32_t)chunk->code.size();
+        compileExpr(whileLoop->condition.get());
+        size_t exitJump = emitJump(OpCode::JUMP_IF_FALSE);
+        compileBlock(whileLoop->body);
+        chunk->emit(OpCode::JUMP);
+        chunk->emitOperand(start);
+        patchJump(exitJump);
+        return;
+    }
+
+    if (auto loop = dynamic_cast<ForStmt*>(stmt)) {
+        auto range = dynamic_cast<CallExpr*>(loop->collection.get());
+        if (range && range->builtin >= 0 && range->builtin == Builtins::find("range")) {
+            compileRangeLoop(loop, range);
+            return;
+        }
+        compileExpr(loop->collection.get());
+        chunk->emit(OpCode::FOR_PREP);
+        emitRef(loop->ref);
+        size_t prepExit = chunk->code.size();
+        chunk->emitOperand(0);
+
+        uint32_t start = (uint32_t)chunk->code.size();
+        chunk->emit(OpCode::FOR_NEXT);
+        emitRef(loop->ref);
+        size_t nextExit = chunk->code.size();
+        chunk->emitOperand(0);
+
+        compileBlock(loop->body);
+        chunk->emit(OpCode::JUMP);
+        chunk->emitOperand(start);
+        patchJump(prepExit);
+        patchJump(nextExit);
+        return;
+    }
+
+    if (auto ret = dynamic_cast<ReturnStmt*>(stmt)) {
+        if (ret->tail) {
+            auto call = static_cast<CallExpr*>(ret->value.get());
+            for (auto& arg : call->args) compileExpr(arg.get());
+            chunk->emit(OpCode::TAIL_CALL);
+            chunk->emitOperand((uint32_t)call->function);
+            chunk->emitOperand((uint32_t)call->args.size());
+        }
+        else if (ret->value) compileExpr(ret->value.get());
+        else chunk->emit(OpCode::NIL);
+        chunk->emit(OpCode::RETURN);
+        return;
+    }
+
+    if (auto tryStmt = dynamic_cast<TryStmt*>(stmt)) {
+        chunk->stmts.push_back(tryStmt);
+        chunk->emit(OpCode::TRY_BEGIN);
+        chunk->emitOperand((uint32_t)(chunk->stmts.size() - 1));
+        size_t catchAt = chunk->code.size();
+        chunk->emitOperand(0);
+        compileBlock(tryStmt->tryBody);
+        chunk->emit(OpCode::TRY_END);
+        size_t endJump = emitJump(OpCode::JUMP);
+        patchJump(catchAt);
+        compileBlock(tryStmt->catchBody);
+        patchJump(endJump);
+        return;
+    }
+
+    if (auto app = dynamic_cast<AppDecl*>(stmt)) {
+        compileBlock(app->body);
+        return;
+    }
+
+    // FuncDecl, ClassDecl, ImportStmt, ClearStmt, PropertyStmt, ... jarang dieksekusi
+    emitFallback(stmt);
+}
+
+// Counted loop: argumen range() langsung jadi start/sisa/step di stack, tidak ada list
+void Compiler::compileRangeLoop(ForStmt* loop, CallExpr* range) {
+    int argc = std::min((int)range->args.size(), Builtins::get(range->builtin).arity);
+    for (int i = 0; i < argc; ++i) compileExpr(range->args[i].get());
+    chunk->emit(OpCode::RANGE_PREP);
+    emitRef(loop->ref);
+    size_t prepExit = chunk->code.size();
+    chunk->emitOperand(0);
+    chunk->emitOperand((uint32_t)argc);
+
+    uint32_t start = (uint32_t)chunk->code.size();
+    chunk->emit(OpCode::RANGE_NEXT);
+    emitRef(loop->ref);
+    size_t nextExit = chunk->code.size();
+    chunk->emitOperand(0);
+
+    compileBlock(loop->body);
+    chunk->emit(OpCode::JUMP);
+    chunk->emitOperand(start);
+    patchJump(prepExit);
+    patchJump(nextExit);
+}
+
+void Compiler::compileCall(int builtin, int function, const std::vector<std::unique_ptr<Expr>>& args, bool asStatement) {
+    if (builtin >= 0) {
+        // Builtin hanya mengevaluasi argumen sebanyak arity-nya
+        int argc = std::min((int)args.size(), Builtins::get(builtin).arity);
+        for (int i = 0; i < argc; ++i) compileExpr(args[i].get());
+        chunk->emit(OpCode::CALL_NATIVE);
+        chunk->emitOperand((uint32_t)builtin);
+        chunk->emitOperand((uint32_t)argc);
+        chunk->emitOperand(asStatement ? 1 : 0);
+        return;
+    }
+    for (auto& arg : args) compileExpr(arg.get());
+    chunk->emit(OpCode::CALL);
+    chunk->emitOperand((uint32_t)function);
+    chunk->emitOperand((uint32_t)args.size());
+}
+
+void Compiler::compileExpr(Expr* expr) {
+    if (!expr) {
+        chunk->emit(OpCode::NIL);
+        return;
+    }
+
+    if (auto num = dynamic_cast<NumberExpr*>(expr)) {
+        chunk->emit(OpCode::CONST);
+        chunk->emitOperand(addConstant(Obj(num->value)));
+        return;
+    }
+    if (auto flt = dynamic_cast<FloatExpr*>(expr)) {
+        chunk->emit(OpCode::CONST);
+        chunk->emitOperand(addConstant(Obj(flt->value)));
+        return;
+    }
+    if (auto str = dynamic_cast<StringExpr*>(expr)) {
+        chunk->emit(OpCode::CONST);
+        chunk->emitOperand(addConstant(str->constant));
+        return;
+    }
+    if (auto chr = dynamic_cast<CharExpr*>(expr)) {
+        chunk->emit(OpCode::CONST);
+        chunk->emitOperand(addConstant(Obj(chr->value)));
+        return;
+    }
+    if (auto bl = dynamic_cast<BoolExpr*>(expr)) {
+        chunk->emit(OpCode::CONST);
+        chunk->emitOperand(addConstant(Obj(bl->value)));
+        return;
+    }
+    if (auto var = dynamic_cast<VariableExpr*>(expr)) {
+        chunk->emit(OpCode::GET_VAR);
+        emitRef(var->ref);
+        return;
+    }
+    if (auto self = dynamic_cast<ThisExpr*>(expr)) {
+        chunk->emit(OpCode::GET_VAR);
+        emitRef(self->ref);
+        return;
+    }
+
+    if (auto bin = dynamic_cast<BinaryExpr*>(expr)) {
+        compileExpr(bin->lhs.get());
+        compileExpr(bin->rhs.get());
+        switch (bin->op) {
+            case '+': chunk->emit(OpCode::ADD); break;
+            case '-': chunk->emit(OpCode::SUB); break;
+            case '*': chunk->emit(OpCode::MUL); break;
+            case '/': chunk->emit(OpCode::DIV); break;
+            case '<': chunk->emit(OpCode::LT); break;
+            case '>': chunk->emit(OpCode::GT); break;
+            case '=': chunk->emit(OpCode::EQ); break;
+            default:
+                chunk->emit(OpCode::POP);
+                chunk->emit(OpCode::POP);
+                chunk->emit(OpCode::NIL);
+                break;
+        }
+        return;
+    }
+
+    if (auto arr = dynamic_cast<ArrayExpr*>(expr)) {
+        for (auto& el : arr->elements) compileExpr(el.get());
+        chunk->emit(OpCode::BUILD_LIST);
+        chunk->emitOperand((uint32_t)arr->elements.size());
+        return;
+    }
+
+    if (auto dictNode = dynamic_cast<DictExpr*>(expr)) {
+        for (auto& p : dictNode->pairs) {
+            compileExpr(p.first.get());
+            compileExpr(p.second.get());
+        }
+        chunk->emit(OpCode::BUILD_DICT);
+        chunk->emitOperand((uint32_t)dictNode->pairs.size());
+        return;
+    }
+
+    if (auto idx = dynamic_cast<IndexExpr*>(expr)) {
+        compileExpr(idx->object.get());
+        compileExpr(idx->index.get());
+        chunk->emit(OpCode::INDEX);
+        return;
+    }
+
+    if (auto get = dynamic_cast<GetExpr*>(expr)) {
+        compileExpr(get->object.get());
+        chunk->exprs.push_back(get);
+        chunk->emit(OpCode::GET_FIELD);
+        chunk->emitOperand((uint32_t)(chunk->exprs.size() - 1));
+        return;
+    }
+
+    if (auto set = dynamic_cast<SetExpr*>(expr)) {
+        compileExpr(set->object.get());
+        compileExpr(set->value.get());
+        chunk->exprs.push_back(set);
+        chunk->emit(OpCode::SET_FIELD);
+        chunk->emitOperand((uint32_t)(chunk->exprs.size() - 1));
+        return;
+    }
+
+    if (auto methodCall = dynamic_cast<MethodCallExpr*>(expr)) {
+        compileExpr(methodCall->object.get());
+        for (auto& arg : methodCall->args) compileExpr(arg.get());
+        chunk->exprs.push_back(methodCall);
+        chunk->emit(OpCode::INVOKE);
+        chunk->emitOperand((uint32_t)(chunk->exprs.size() - 1));
+        chunk->emitOperand((uint32_t)methodCall->args.size());
+        return;
+    }
+
+    if (auto newExpr = dynamic_cast<NewExpr*>(expr)) {
+        for (auto& arg : newExpr->args) compileExpr(arg.get());
+        chunk->exprs.push_back(newExpr);
+        chunk->emit(OpCode::NEW);
+        chunk->emitOperand((uint32_t)(chunk->exprs.size() - 1));
+        chunk->emitOperand((uint32_t)newExpr->args.size());
+        return;
+    }
+
+    if (auto call = dynamic_cast<CallExpr*>(expr)) {
+        compileCall(call->builtin, call->function, call->args, false);
+        return;
+    }
+
+    // InputExpr
+    emitFallback(expr);
+}
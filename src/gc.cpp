@@ -0,0 +1,208 @@
+#include "gc.h"
+#include <algorithm>
+#include <vector>
+
+namespace Gc {
+    size_t containers = 0;
+    bool pending = false;
+}
+
+namespace {
+    enum Color : uint8_t { Black = 0, Gray, White, Garbage };
+
+    std::vector<HeapObject*> roots;          // kandidat akar siklus (gcBuffered = true)
+    size_t threshold = Gc::MIN_HEAP;         // collection berikutnya saat container sebanyak ini
+    std::vector<HeapObject*> work;           // stack traversal, dipakai ulang antar collection
+
+    // Panggil f untuk setiap Value anak yang berupa container
+    template <typename F>
+    void eachChild(HeapObject* o, F f) {
+        switch (o->type) {
+            case Type::List:
+                for (Value& v : *static_cast<List*>(o)) if (isContainerType(v.type)) f(v);
+                break;
+            case Type::Dict:
+                for (auto& entry : *static_cast<Dict*>(o)) if (isContainerType(entry.second.type)) f(entry.second);
+                break;
+            case Type::Instance:
+                for (Value& v : static_cast<LinkInstance*>(o)->fields) if (isContainerType(v.type)) f(v);
+                break;
+            default: break;
+        }
+    }
+
+    size_t footprint(HeapObject* o) {
+        switch (o->type) {
+            case Type::List: {
+                List* list = static_cast<List*>(o);
+                return sizeof(List) + list->capacity() * sizeof(Value);
+            }
+            case Type::Dict: {
+                Dict* dict = static_cast<Dict*>(o);
+                size_t node = sizeof(std::string) + sizeof(Value) + 2 * sizeof(void*);
+                return sizeof(Dict) + dict->bucket_count() * sizeof(void*) + dict->size() * node;
+            }
+            case Type::Instance:
+                return sizeof(LinkInstance) + static_cast<LinkInstance*>(o)->fields.capacity() * sizeof(Value);
+            default: return 0;
+        }
+    }
+
+    void destroy(HeapObject* o) {
+        switch (o->type) {
+            case Type::List: delete static_cast<List*>(o); break;
+            case Type::Dict: delete static_cast<Dict*>(o); break;
+            case Type::Instance: delete static_cast<LinkInstance*>(o); break;
+            default: break;
+        }
+    }
+
+    // Kurangi refcount sepanjang edge internal; yang tersisa > 0 berarti dipegang dari luar subgraph
+    void markGray(HeapObject* root) {
+        if (root->gcColor == Gray) return;
+        root->gcColor = Gray;
+        work.push_back(root);
+        while (!work.empty()) {
+            HeapObject* o = work.back();
+            work.pop_back();
+            eachChild(o, [](Value& v) {
+                v.heap->refs--;
+                if (v.heap->gcColor != Gray) {
+                    v.heap->gcColor = Gray;
+                    work.push_back(v.heap);
+                }
+            });
+        }
+    }
+
+    // Objek masih hidup: kembalikan refcount semua yang bisa dicapai darinya
+    void scanBlack(HeapObject* root) {
+        root->gcColor = Black;
+        work.push_back(root);
+        while (!work.empty()) {
+            HeapObject* o = work.back();
+            work.pop_back();
+            eachChild(o, [](Value& v) {
+                v.heap->refs++;
+                if (v.heap->gcColor != Black) {
+                    v.heap->gcColor = Black;
+                    work.push_back(v.heap);
+                }
+            });
+        }
+    }
+
+    void scan(HeapObject* root) {
+        std::vector<HeapObject*> pendingScan{root};
+        while (!pendingScan.empty()) {
+            HeapObject* o = pendingScan.back();
+            pendingScan.pop_back();
+            if (o->gcColor != Gray) continue;
+            if (o->refs > 0) {
+                scanBlack(o);
+                continue;
+            }
+            o->gcColor = White;
+            eachChild(o, [&](Value& v) { pendingScan.push_back(v.heap); });
+        }
+    }
+
+    void collectWhite(HeapObject* root, std::vector<HeapObject*>& garbage) {
+        work.push_back(root);
+        while (!work.empty()) {
+            HeapObject* o = work.back();
+            work.pop_back();
+            if (o->gcColor != White) continue;
+            o->gcColor = Garbage;
+            garbage.push_back(o);
+            eachChild(o, [](Value& v) { work.push_back(v.heap); });
+        }
+    }
+
+    // Trial deletion untuk kandidat roots[from..]; kandidat itu keluar dari buffer
+    size_t collectRoots(size_t from) {
+        std::vector<HeapObject*> slice(roots.begin() + from, roots.end());
+        roots.resize(from);
+
+        size_t freed = 0;
+        size_t live = 0;
+        for (HeapObject* o : slice) {
+            o->gcBuffered = false;
+            if (o->refs == 0) {
+                // Cangkang yang isinya sudah dilepas releaseBuffered()
+                freed += footprint(o);
+                destroy(o);
+                continue;
+            }
+            slice[live++] = o;
+        }
+        slice.resize(live);
+
+        for (HeapObject* o : slice) markGray(o);
+        for (HeapObject* o : slice) scan(o);
+        std::vector<HeapObject*> garbage;
+        for (HeapObject* o : slice) collectWhite(o, garbage);
+        if (garbage.empty()) return freed;
+
+        // Sampah yang masih tercatat di sisa buffer dikeluarkan dulu sebelum dibebaskan
+        size_t kept = 0;
+        for (HeapObject* o : roots) {
+            if (o->gcColor != Garbage) roots[kept++] = o;
+        }
+        roots.resize(kept);
+
+        // Refcount antar sampah sudah dikurangi markGray: edge ke container diputus tanpa release
+        for (HeapObject* o : garbage) {
+            freed += footprint(o);
+            eachChild(o, [](Value& v) { v.type = Type::Nil; });
+        }
+        for (HeapObject* o : garbage) destroy(o);
+        return freed;
+    }
+
+    void finishCycle() {
+        Gc::pending = false;
+        threshold = std::max(Gc::MIN_HEAP, Gc::containers * 2);
+    }
+}
+
+namespace Gc {
+    void possibleRoot(HeapObject* o) {
+        o->gcBuffered = true;
+        roots.push_back(o);
+        if (containers >= threshold || roots.size() >= MAX_ROOTS) pending = true;
+    }
+
+    void releaseBuffered(HeapObject* o) {
+        // Kasus umum: objek berumur pendek yang baru saja dicatat langsung dikembalikan ke pool
+        if (roots.back() == o) {
+            roots.pop_back();
+            o->gcBuffered = false;
+            destroy(o);
+            return;
+        }
+        // Masih ada di tengah buffer kandidat: isinya dilepas sekarang, cangkangnya dibebaskan collector
+        switch (o->type) {
+            case Type::List: std::vector<Value>().swap(*static_cast<List*>(o)); break;
+            case Type::Dict: std::unordered_map<std::string, Value>().swap(*static_cast<Dict*>(o)); break;
+            case Type::Instance: {
+                LinkInstance* instance = static_cast<LinkInstance*>(o);
+                std::vector<Value>().swap(instance->fields);
+                instance->klass = Ref<LinkClass>();
+                break;
+            }
+            default: break;
+        }
+    }
+
+    void step() {
+        collectRoots(roots.size() > SLICE_ROOTS ? roots.size() - SLICE_ROOTS : 0);
+        if (roots.empty()) finishCycle();
+    }
+
+    size_t collect() {
+        size_t freed = collectRoots(0);
+        finishCycle();
+        return freed;
+    }
+}
@@ -15,6 +15,17 @@ USAGE:
   ./link                  : Enter Interactive Mode (REPL).
   ./link <file.link>      : Execute a Link-Lang script file.
   ./link --help           : Show this manual.
+  ./link --engine=vm <f>  : Run with the bytecode VM (default: walker).
+  ./link --jit <f>        : Compile hot numeric functions to x86-64 code.
+  ./link --stream <f>     : Run each top-level statement as soon as it is parsed
+                            (huge generated scripts: low memory, early output).
+  ./link --bench-lex <f>  : Only tokenize <f> and report lexer MB/s.
+  ./link --no-cache <f>   : Always re-parse; parsed scripts and imports are
+                            normally cached in __linkcache__/ next to the file.
+  ./link --snapshot <img> <lib>
+                          : Run <lib> and save its global state to <img>.
+  ./link --image <img> <f>: Start from the state in <img>, then run <f>
+                            (library code in the image is not run again).
 
 DATA TYPES:
   Integer  : 10, 25, -5
@@ -30,8 +41,10 @@ BASIC COMMANDS:
   set x = 10              : Variable declaration.
   print(x)                : Output to screen.
   input("Message: ")      : Get user input.
-  import "file.link"      : Import other script files.
+  import "file.link"      : Import other script files (each file runs once).
+  lazy import "file.link" : Load the file only when one of its names is first used.
   sh "ls -la"             : Quick shell command execution.
+  memo func fib(n)        : Cache results per argument (pure functions only).
 
 OBJECT ORIENTED PROGRAMMING (New!):
   class Robot {           : Define a class.
@@ -75,14 +88,20 @@ BUILT-IN LIBRARIES:
   os.exec("cmd")          : Execute shell command.
   os.getenv("KEY")        : Get env variable.
   os.setenv("K","V")      : Set env variable.
+  sys.memoSize(n)         : Limit cached results of 'memo func' (0 = off).
+  sys.memoClear()         : Drop all cached 'memo func' results.
+  sys.gc()                : Collect unreachable cycles, returns bytes freed.
+  sys.heapStats()         : Allocator pool stats per object type (Dict).
 
   [LIST & DATA]
   list.add(lst, item)     : Add item to list.
   len(obj)                : Get length of String or List.
-  range(n)                : Generate list [0, 1, ... n-1].
+  range(n)                : Range 0 .. n-1 (also range(a, b), range(a, b, step)).
 
   [FILE I/O]
   io.read("path")         : Read file content.
+  io.read("p", off, len)  : Read only len bytes from off (large files).
+  io.size("path")         : File size in bytes (-1 if missing).
   io.write("p", "txt")    : Write to file (Overwrite).
   io.append("p", "txt")   : Append to file.
   io.exists("path")       : Check file existence.
@@ -0,0 +1,402 @@
+#include "image.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+#include "astcache.h"
+#include "intern.h"
+#include "os.h"
+
+namespace Image {
+
+    // Format: Header lalu payload: program (AstCache::encode), modul, fungsi, global.
+    // Nilai heap ditulis lengkap saat pertama ditemui, berikutnya cukup id (urutan kemunculan).
+    static const char MAGIC[8] = {'L', 'I', 'N', 'K', 'I', 'M', 'G', '\0'};
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t programs;
+        uint64_t payloadHash;
+    };
+
+    enum class Tag : uint8_t { Nil, Int, Double, Char, Bool, String, List, Range, Dict, Class, Instance, Seen };
+
+    struct Corrupt : std::runtime_error {
+        Corrupt() : std::runtime_error("corrupt image") {}
+    };
+
+    // FuncDecl / ClassDecl preorder; urutannya sama selama AST sama, jadi index-nya alamat yang stabil
+    static void collectDeclarations(const std::vector<std::unique_ptr<Stmt>>& body, std::vector<Stmt*>& out) {
+        for (auto& stmt : body) {
+            Stmt* s = stmt.get();
+            if (auto func = dynamic_cast<FuncDecl*>(s)) {
+                out.push_back(func);
+                collectDeclarations(func->body, out);
+            }
+            else if (auto cls = dynamic_cast<ClassDecl*>(s)) {
+                out.push_back(cls);
+                for (auto& method : cls->methods) {
+                    out.push_back(method.get());
+                    collectDeclarations(method->body, out);
+                }
+            }
+            else if (auto ifStmt = dynamic_cast<IfStmt*>(s)) {
+                collectDeclarations(ifStmt->thenBranch, out);
+                collectDeclarations(ifStmt->elseBranch, out);
+            }
+            else if (auto whileLoop = dynamic_cast<WhileStmt*>(s)) collectDeclarations(whileLoop->body, out);
+            else if (auto loop = dynamic_cast<ForStmt*>(s)) collectDeclarations(loop->body, out);
+            else if (auto tryStmt = dynamic_cast<TryStmt*>(s)) {
+                collectDeclarations(tryStmt->tryBody, out);
+                collectDeclarations(tryStmt->catchBody, out);
+            }
+            else if (auto app = dynamic_cast<AppDecl*>(s)) collectDeclarations(app->body, out);
+            else if (auto window = dynamic_cast<WindowDecl*>(s)) collectDeclarations(window->body, out);
+        }
+    }
+
+    class Writer {
+    public:
+        std::string body;
+
+        explicit Writer(const std::vector<const Program*>& programs) {
+            for (size_t p = 0; p < programs.size(); p++) {
+                std::vector<Stmt*> decls;
+                collectDeclarations(programs[p]->statements, decls);
+                for (size_t d = 0; d < decls.size(); d++) where[decls[d]] = {(uint32_t)p, (uint32_t)d};
+            }
+        }
+
+        void byte(uint8_t b) { body.push_back(static_cast<char>(b)); }
+        void tag(Tag t) { byte(static_cast<uint8_t>(t)); }
+        void varint(uint64_t v) {
+            while (v >= 0x80) { byte(static_cast<uint8_t>(v | 0x80)); v >>= 7; }
+            byte(static_cast<uint8_t>(v));
+        }
+        void integer(int64_t v) { varint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63)); }
+        void real(double v) {
+            char bytes[8];
+            std::memcpy(bytes, &v, 8);
+            body.append(bytes, 8);
+        }
+        void text(const std::string& s) {
+            varint(s.size());
+            body += s;
+        }
+
+        // false kalau deklarasi bukan milik salah satu program di image
+        bool decl(const Stmt* s) {
+            auto it = where.find(s);
+            if (it == where.end()) return false;
+            varint(it->second.first);
+            varint(it->second.second);
+            return true;
+        }
+
+        void value(const Obj& v);
+
+    private:
+        std::unordered_map<const Stmt*, std::pair<uint32_t, uint32_t>> where;
+        std::unordered_map<const HeapObject*, uint32_t> seen;
+    };
+
+    void Writer::value(const Obj& v) {
+        if (v.isHeap()) {
+            auto it = seen.find(v.heap);
+            if (it != seen.end()) {
+                tag(Tag::Seen);
+                varint(it->second);
+                return;
+            }
+            seen.emplace(v.heap, static_cast<uint32_t>(seen.size()));
+        }
+        switch (v.type) {
+            case Type::Nil: tag(Tag::Nil); break;
+            case Type::Int: tag(Tag::Int); integer(v.asInt()); break;
+            case Type::Double: tag(Tag::Double); real(v.asDouble()); break;
+            case Type::Char: tag(Tag::Char); byte(static_cast<uint8_t>(v.asChar())); break;
+            case Type::Bool: tag(Tag::Bool); byte(v.asBool() ? 1 : 0); break;
+            case Type::String:
+                tag(Tag::String);
+                byte(static_cast<LinkString*>(v.heap)->interned ? 1 : 0);
+                text(v.asString());
+                break;
+            case Type::List: {
+                List* list = v.asLazyList();
+                if (list->lazy) {
+                    tag(Tag::Range);
+                    integer(list->start);
+                    integer(list->step);
+                    integer(list->count);
+                    break;
+                }
+                tag(Tag::List);
+                varint(list->size());
+                for (auto& item : *list) value(item);
+                break;
+            }
+            case Type::Dict: {
+                // Dibaca ulang dengan jumlah bucket sama dan urutan terbalik: urutan iterasi
+                // (dan jadi output print) sama dengan sebelum snapshot
+                Dict* dict = v.asDict();
+                tag(Tag::Dict);
+                varint(dict->bucket_count());
+                varint(dict->size());
+                std::vector<const Dict::value_type*> entries;
+                for (auto& entry : *dict) entries.push_back(&entry);
+                for (size_t i = entries.size(); i-- > 0;) {
+                    text(entries[i]->first);
+                    value(entries[i]->second);
+                }
+                break;
+            }
+            case Type::Class:
+                tag(Tag::Class);
+                if (!decl(v.asClass()->decl)) throw std::logic_error("Image: class outside loaded programs");
+                break;
+            case Type::Instance: {
+                LinkInstance* instance = v.asInstance();
+                tag(Tag::Instance);
+                value(Obj(instance->klass));
+                varint(instance->fields.size());
+                for (size_t i = 0; i < instance->fields.size(); i++) {
+                    text(instance->shape->names[i]->value);
+                    value(instance->fields[i]);
+                }
+                break;
+            }
+        }
+    }
+
+    class Reader {
+    public:
+        Reader(const char* data, size_t size) : p(reinterpret_cast<const uint8_t*>(data)), end(p + size) {}
+
+        uint8_t byte() { if (p >= end) throw Corrupt(); return *p++; }
+        uint64_t varint() {
+            uint64_t v = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                uint8_t b = byte();
+                v |= static_cast<uint64_t>(b & 0x7F) << shift;
+                if (!(b & 0x80)) return v;
+            }
+            throw Corrupt();
+        }
+        int64_t integer() { uint64_t v = varint(); return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+        double real() { double v; std::memcpy(&v, bytes(8).data(), 8); return v; }
+        std::string_view bytes(size_t n) {
+            if (static_cast<size_t>(end - p) < n) throw Corrupt();
+            std::string_view view(reinterpret_cast<const char*>(p), n);
+            p += n;
+            return view;
+        }
+        size_t count() { uint64_t n = varint(); if (n > static_cast<size_t>(end - p)) throw Corrupt(); return n; } // tiap item >= 1 byte
+        std::string text() { return std::string(bytes(varint())); }
+
+        void addProgram(const Program& program) {
+            decls.emplace_back();
+            collectDeclarations(program.statements, decls.back());
+        }
+
+        Stmt* decl() {
+            uint64_t program = varint(), index = varint();
+            if (program >= decls.size() || index >= decls[program].size()) throw Corrupt();
+            return decls[program][index];
+        }
+
+        Obj value();
+
+    private:
+        const uint8_t* p;
+        const uint8_t* end;
+        std::vector<std::vector<Stmt*>> decls;
+        std::vector<Obj> objects; // id -> objek heap yang sudah dibuat
+    };
+
+    Obj Reader::value() {
+        Tag t = static_cast<Tag>(byte());
+        switch (t) {
+            case Tag::Nil: return Obj();
+            case Tag::Int: return Obj(static_cast<int>(integer()));
+            case Tag::Double: return Obj(real());
+            case Tag::Char: return Obj(static_cast<char>(byte()));
+            case Tag::Bool: return Obj(byte() != 0);
+            case Tag::Seen: {
+                uint64_t id = varint();
+                if (id >= objects.size()) throw Corrupt();
+                return objects[id];
+            }
+            case Tag::String: {
+                bool interned = byte() != 0;
+                std::string s = text();
+                objects.push_back(interned ? Intern::get(s) : Obj(std::move(s)));
+                return objects.back();
+            }
+            case Tag::Range: {
+                int start = static_cast<int>(integer()), step = static_cast<int>(integer()), n = static_cast<int>(integer());
+                objects.push_back(Obj(List::range(start, step, n)));
+                return objects.back();
+            }
+            case Tag::List: {
+                // Objek didaftarkan sebelum isinya dibaca: elemen boleh menunjuk balik (siklus)
+                auto list = makeRef<List>();
+                objects.push_back(Obj(list));
+                size_t n = count();
+                list->reserve(n);
+                for (size_t i = 0; i < n; i++) list->push_back(value());
+                return Obj(list);
+            }
+            case Tag::Dict: {
+                auto dict = makeRef<Dict>();
+                objects.push_back(Obj(dict));
+                uint64_t buckets = varint();
+                size_t n = count();
+                if (buckets > 2 * n + 16) throw Corrupt();
+                dict->rehash(buckets);
+                for (size_t i = 0; i < n; i++) {
+                    std::string key = text();
+                    (*dict)[key] = value();
+                }
+                return Obj(dict);
+            }
+            case Tag::Class: {
+                size_t id = objects.size();
+                objects.emplace_back();
+                auto cls = dynamic_cast<ClassDecl*>(decl());
+                if (!cls) throw Corrupt();
+                objects[id] = Obj(makeClass(cls));
+                return objects[id];
+            }
+            case Tag::Instance: {
+                auto instance = makeRef<LinkInstance>();
+                objects.push_back(Obj(instance));
+                Obj klass = value();
+                if (!klass.isClass()) throw Corrupt();
+                instance->klass = Ref<LinkClass>(klass.asClass());
+                size_t n = count();
+                for (size_t i = 0; i < n; i++) {
+                    std::string field = text();
+                    instance->shape = instance->shape->withField(Intern::symbol(field));
+                    instance->fields.push_back(value());
+                }
+                return Obj(instance);
+            }
+        }
+        throw Corrupt();
+    }
+
+    bool save(const std::string& path, const State& state) {
+        Writer writer(state.programs);
+        for (const Program* program : state.programs) writer.text(AstCache::encode(*program));
+
+        writer.varint(state.modules.size());
+        for (auto& module : state.modules) {
+            writer.text(module.path);
+            writer.text(module.name);
+            writer.varint(module.program == NO_PROGRAM ? 0 : module.program + 1);
+            writer.integer(module.size);
+            writer.integer(module.mtime);
+        }
+
+        writer.varint(state.functions.size());
+        for (auto& function : state.functions) {
+            writer.text(function.first);
+            if (!writer.decl(function.second)) return false;
+        }
+
+        writer.varint(state.globals.size());
+        for (auto& global : state.globals) {
+            writer.text(global.first);
+            writer.value(global.second);
+        }
+
+        Header header;
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = FORMAT_VERSION;
+        header.programs = static_cast<uint32_t>(state.programs.size());
+        header.payloadHash = AstCache::contentHash(writer.body);
+
+        // Sama seperti cache AST: tulis ke file sementara lalu rename
+        std::string temp = path + ".tmp" + std::to_string(Sys::processId());
+        {
+            std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+            if (!out) return false;
+            out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+            out << writer.body;
+            if (!out) { out.close(); std::remove(temp.c_str()); return false; }
+        }
+        if (std::rename(temp.c_str(), path.c_str()) != 0) {
+            std::remove(temp.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    bool load(const std::string& path, State& state, std::string& error) {
+        Sys::MappedFile file(path);
+        std::string_view data = file.text();
+        if (!file.isOpen()) {
+            error = "Cannot open image '" + path + "'.";
+            return false;
+        }
+        Header header;
+        if (data.size() < sizeof(Header)) {
+            error = "Image '" + path + "' is corrupt.";
+            return false;
+        }
+        std::memcpy(&header, data.data(), sizeof(Header));
+        std::string_view payload = data.substr(sizeof(Header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != FORMAT_VERSION) {
+            error = "Image '" + path + "' was made by another version of Link. Rebuild it with --snapshot.";
+            return false;
+        }
+        if (header.payloadHash != AstCache::contentHash(payload)) {
+            error = "Image '" + path + "' is corrupt.";
+            return false;
+        }
+
+        try {
+            Reader reader(payload.data(), payload.size());
+            for (uint32_t i = 0; i < header.programs; i++) {
+                auto program = AstCache::decode(reader.bytes(reader.varint()));
+                if (!program) throw Corrupt();
+                reader.addProgram(*program);
+                state.owned.push_back(std::move(program));
+            }
+
+            state.modules.resize(reader.count());
+            for (auto& module : state.modules) {
+                module.path = reader.text();
+                module.name = reader.text();
+                uint64_t program = reader.varint();
+                if (program > header.programs) throw Corrupt();
+                module.program = program == 0 ? NO_PROGRAM : static_cast<uint32_t>(program - 1);
+                module.size = reader.integer();
+                module.mtime = reader.integer();
+                if (Sys::fileSize(module.path) != module.size || Sys::fileTime(module.path) != module.mtime) {
+                    error = "Image '" + path + "' is stale: '" + module.name + "' changed. Rebuild it with --snapshot.";
+                    return false;
+                }
+            }
+
+            state.functions.resize(reader.count());
+            for (auto& function : state.functions) {
+                function.first = reader.text();
+                function.second = dynamic_cast<FuncDecl*>(reader.decl());
+                if (!function.second) throw Corrupt();
+            }
+
+            state.globals.resize(reader.count());
+            for (auto& global : state.globals) {
+                global.first = reader.text();
+                global.second = reader.value();
+            }
+        } catch (const Corrupt&) {
+            error = "Image '" + path + "' is corrupt.";
+            return false;
+        }
+        return true;
+    }
+}
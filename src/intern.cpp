@@ -0,0 +1,43 @@
+#include "intern.h"
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace Intern {
+
+    // Key menunjuk ke isi LinkString milik entry itu sendiri (immutable, tidak pernah dilepas)
+    static std::unordered_map<std::string_view, Obj>& table() {
+        static std::unordered_map<std::string_view, Obj> strings;
+        return strings;
+    }
+
+    // Parser di thread prefetch (lihat prefetch.h) juga meng-intern nama
+    static std::mutex lock;
+
+    static const Obj& entry(std::string_view text) {
+        auto& strings = table();
+        auto it = strings.find(text);
+        if (it != strings.end()) return it->second;
+
+        Obj value{std::string(text)};
+        static_cast<LinkString*>(value.heap)->interned = true;
+        std::string_view key = value.asString();
+        return strings.emplace(key, std::move(value)).first->second;
+    }
+
+    Obj get(std::string_view text) {
+        std::lock_guard<std::mutex> guard(lock);
+        return entry(text);
+    }
+
+    // Tanpa salinan Obj: refcount string intern tidak disentuh dari thread lain
+    const LinkString* symbol(std::string_view name) {
+        std::lock_guard<std::mutex> guard(lock);
+        return static_cast<const LinkString*>(entry(name).heap);
+    }
+
+    size_t size() {
+        std::lock_guard<std::mutex> guard(lock);
+        return table().size();
+    }
+}
@@ -0,0 +1,735 @@
+#include "jit.h"
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include "builtins.h"
+
+#if defined(__x86_64__) && defined(__linux__)
+#include <pthread.h>
+#include <sys/mman.h>
+#define LINK_JIT_X64 1
+#endif
+
+namespace {
+
+#ifdef LINK_JIT_X64
+// Batas bawah stack thread ini + STACK_RESERVE; tanpa info stack, 1 MB di bawah posisi sekarang
+uint64_t stackFloor() {
+    char here;
+    uint64_t floor = (uint64_t)(uintptr_t)&here - 1024 * 1024;
+    pthread_attr_t attr;
+    if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+        void* low;
+        size_t size;
+        if (pthread_attr_getstack(&attr, &low, &size) == 0) floor = (uint64_t)(uintptr_t)low + Jit::STACK_RESERVE;
+        pthread_attr_destroy(&attr);
+    }
+    return floor;
+}
+#endif
+
+bool isValue(JitType t) { return t == JitType::Int || t == JitType::Double || t == JitType::Bool; }
+
+JitType join(JitType a, JitType b) {
+    if (a == JitType::None) return b;
+    if (b == JitType::None) return a;
+    return a == b ? a : JitType::Invalid;
+}
+
+bool containsLoop(const std::vector<std::unique_ptr<Stmt>>& body) {
+    for (auto& s : body) {
+        if (dynamic_cast<WhileStmt*>(s.get()) || dynamic_cast<ForStmt*>(s.get())) return true;
+        if (auto ifStmt = dynamic_cast<IfStmt*>(s.get())) {
+            if (containsLoop(ifStmt->thenBranch) || containsLoop(ifStmt->elseBranch)) return true;
+        }
+    }
+    return false;
+}
+
+// Encoder x86-64 minimal. Konvensi: int/bool di eax, double di xmm0,
+// variabel di [rbp - 8*(slot+1)], temporary di-push ke stack.
+struct Assembler {
+    std::vector<uint8_t> code;
+
+    void emit(std::initializer_list<uint8_t> bytes) { code.insert(code.end(), bytes); }
+    void imm32(int32_t v) {
+        size_t at = code.size();
+        code.resize(at + 4);
+        std::memcpy(&code[at], &v, 4);
+    }
+    void imm64(uint64_t v) {
+        size_t at = code.size();
+        code.resize(at + 8);
+        std::memcpy(&code[at], &v, 8);
+    }
+
+    // Instruksi lompat rel32; hasilnya posisi operand untuk di-patch
+    size_t jump(std::initializer_list<uint8_t> op) {
+        emit(op);
+        size_t at = code.size();
+        imm32(0);
+        return at;
+    }
+    void patchTo(size_t at, size_t target) {
+        int32_t rel = (int32_t)(target - (at + 4));
+        std::memcpy(&code[at], &rel, 4);
+    }
+    void patch(size_t at) { patchTo(at, code.size()); }
+    void jumpTo(std::initializer_list<uint8_t> op, size_t target) { patchTo(jump(op), target); }
+
+    void slotOp(std::initializer_list<uint8_t> op, int slot) { // op [rbp + disp32]
+        emit(op);
+        imm32(-8 * (slot + 1));
+    }
+};
+
+class JitCompiler {
+public:
+    JitCompiler(Jit& jit, const std::vector<FuncDecl*>& registry, FuncDecl* fn, JitSpec* spec)
+        : jit(jit), registry(registry), fn(fn), spec(spec), rangeId(Builtins::find("range")) {}
+
+    bool compile(std::vector<uint8_t>& out) {
+        if (!analyze()) return false;
+
+        // push rbp; mov rbp, rsp; sub rsp, <frame>
+        as.emit({0x55, 0x48, 0x89, 0xE5, 0x48, 0x81, 0xEC});
+        size_t frameAt = as.code.size();
+        as.imm32(0);
+        // Rekursi non-tail memakai stack C: di bawah jit.stackFloor berhenti dan tandai overflow
+        as.emit({0x48, 0xB8});
+        as.imm64((uint64_t)(uintptr_t)&jit.stackFloor); // mov rax, &stackFloor
+        as.emit({0x48, 0x3B, 0x20});                     // cmp rsp, [rax]
+        size_t enough = as.jump({0x0F, 0x83});           // jae
+        as.emit({0x48, 0xB8});
+        as.imm64((uint64_t)(uintptr_t)&jit.overflow);
+        as.emit({0x48, 0xC7, 0x00, 0x01, 0x00, 0x00, 0x00}); // mov qword [rax], 1
+        as.emit({0x31, 0xC0, 0xC9, 0xC3});                   // xor eax, eax; leave; ret
+        as.patch(enough);
+        for (size_t i = 0; i < fn->params.size(); ++i) {
+            as.emit({0x48, 0x8B, 0x87}); // mov rax, [rdi + 8*i]
+            as.imm32((int32_t)(8 * i));
+            as.slotOp({0x48, 0x89, 0x85}, (int)i);
+        }
+        nextSlot = fn->frameSize;
+        bodyStart = as.code.size();
+        bool returns = false;
+        if (!genBlock(fn->body, returns) || failed) return false;
+        if (!returns) as.emit({0x31, 0xC0, 0xC9, 0xC3}); // return nil
+
+        int32_t frame = (int32_t)(((nextSlot * 8) + 15) & ~15);
+        std::memcpy(&as.code[frameAt], &frame, 4);
+        out = std::move(as.code);
+        return true;
+    }
+
+private:
+    Jit& jit;
+    const std::vector<FuncDecl*>& registry;
+    FuncDecl* fn;
+    JitSpec* spec;
+    int rangeId;
+    std::vector<JitType> slots; // tipe tiap slot frame (sama di seluruh fungsi)
+    Assembler as;
+    int nextSlot = 0;  // slot tambahan (counter/limit for-range) setelah frameSize
+    int depth = 0;     // qword yang sedang di-push di atas frame, untuk alignment call
+    size_t bodyStart = 0; // setelah prolog, target lompat tail call ke diri sendiri
+    bool failed = false;
+
+    // --- Analisis tipe ---
+    // Diulang sampai tipe return stabil, supaya fungsi rekursif (fib) dapat tipe dari base case-nya.
+    bool analyze() {
+        if (fn->frameSize < (int)fn->params.size()) return false;
+        spec->ret = JitType::None;
+        for (int pass = 0; pass < 4; ++pass) {
+            JitType before = spec->ret;
+            slots.assign(fn->frameSize, JitType::None);
+            std::vector<bool> defined(fn->frameSize, false);
+            for (size_t i = 0; i < fn->params.size(); ++i) {
+                slots[i] = spec->params[i];
+                defined[i] = true;
+            }
+            bool returns = false;
+            if (!analyzeBlock(fn->body, defined, returns)) return false;
+            if (!returns) spec->ret = join(spec->ret, JitType::Nil);
+            if (spec->ret == JitType::Invalid) return false;
+            if (spec->ret == before) return spec->ret != JitType::None;
+        }
+        return false;
+    }
+
+    JitSpec* callee(int function, const std::vector<std::unique_ptr<Expr>>& args, bool& pending) {
+        pending = false;
+        if (function < 0 || function >= (int)registry.size() || !registry[function]) return nullptr;
+        FuncDecl* target = registry[function];
+        if (target->memo) return nullptr; // cache memo hanya dicek interpreter
+        if (args.size() != target->params.size() || args.size() > (size_t)Jit::MAX_PARAMS) return nullptr;
+        JitType types[Jit::MAX_PARAMS];
+        for (size_t i = 0; i < args.size(); ++i) {
+            types[i] = typeOf(args[i].get());
+            if (types[i] == JitType::None) pending = true;
+            else if (types[i] != JitType::Int && types[i] != JitType::Double) return nullptr;
+        }
+        if (pending) return nullptr;
+        JitSpec* found = jit.specialize(target, types, args.size());
+        if (!found || (found != spec && !found->code)) return nullptr;
+        return found;
+    }
+
+    JitType typeOf(Expr* expr) {
+        if (dynamic_cast<NumberExpr*>(expr)) return JitType::Int;
+        if (dynamic_cast<FloatExpr*>(expr)) return JitType::Double;
+        if (dynamic_cast<BoolExpr*>(expr)) return JitType::Bool;
+        if (auto var = dynamic_cast<VariableExpr*>(expr)) {
+            return var->ref.local >= 0 ? slots[var->ref.local] : JitType::Invalid;
+        }
+        if (auto bin = dynamic_cast<BinaryExpr*>(expr)) {
+            JitType l = typeOf(bin->lhs.get()), r = typeOf(bin->rhs.get());
+            if (l == JitType::Invalid || r == JitType::Invalid) return JitType::Invalid;
+            if (l == JitType::None || r == JitType::None) return JitType::None;
+            // binaryOp mengembalikan nil untuk bool / nil
+            if (l != JitType::Int && l != JitType::Double) return JitType::Invalid;
+            if (r != JitType::Int && r != JitType::Double) return JitType::Invalid;
+            switch (bin->op) {
+                case '+': case '-': case '*': case '/':
+                    return (l == JitType::Int && r == JitType::Int) ? JitType::Int : JitType::Double;
+                case '<': case '>': case '=':
+                    return JitType::Bool;
+            }
+            return JitType::Invalid;
+        }
+        if (auto call = dynamic_cast<CallExpr*>(expr)) {
+            if (call->builtin >= 0) return JitType::Invalid;
+            bool pending;
+            JitSpec* target = callee(call->function, call->args, pending);
+            if (pending) return JitType::None;
+            return target ? target->ret : JitType::Invalid;
+        }
+        return JitType::Invalid;
+    }
+
+    // Variabel lokal harus sudah pasti ter-define; kalau tidak, interpreter akan membaca global
+    bool readable(Expr* expr, const std::vector<bool>& defined) {
+        if (auto var = dynamic_cast<VariableExpr*>(expr)) {
+            return var->ref.local >= 0 && defined[var->ref.local];
+        }
+        if (auto bin = dynamic_cast<BinaryExpr*>(expr)) {
+            return readable(bin->lhs.get(), defined) && readable(bin->rhs.get(), defined);
+        }
+        if (auto call = dynamic_cast<CallExpr*>(expr)) {
+            for (auto& arg : call->args) {
+                if (!readable(arg.get(), defined)) return false;
+            }
+        }
+        return true;
+    }
+
+    bool isCondition(JitType t) { return t == JitType::None || isValue(t); }
+
+    bool analyzeBlock(const std::vector<std::unique_ptr<Stmt>>& body, std::vector<bool>& defined, bool& returns) {
+        returns = false;
+        for (auto& s : body) {
+            if (!analyzeStmt(s.get(), defined, returns)) return false;
+            if (returns) break; // sisanya tidak pernah dijalankan
+        }
+        return true;
+    }
+
+    bool analyzeStmt(Stmt* stmt, std::vector<bool>& defined, bool& returns) {
+        if (auto set = dynamic_cast<SetStmt*>(stmt)) {
+            int slot = set->ref.local;
+            if (slot < 0 || !readable(set->expression.get(), defined)) return false;
+            JitType t = typeOf(set->expression.get());
+            if (!isCondition(t)) return false;
+            slots[slot] = join(slots[slot], t);
+            defined[slot] = true;
+            return slots[slot] != JitType::Invalid;
+        }
+        if (auto up = dynamic_cast<UpdateStmt*>(stmt)) {
+            return up->ref.local >= 0 && defined[up->ref.local];
+        }
+        if (auto exprStmt = dynamic_cast<ExprStmt*>(stmt)) {
+            Expr* expr = exprStmt->expression.get();
+            return expr && readable(expr, defined) && typeOf(expr) != JitType::Invalid;
+        }
+        if (auto call = dynamic_cast<CallStmt*>(stmt)) {
+            if (call->builtin >= 0) return false;
+            for (auto& arg : call->args) {
+                if (!readable(arg.get(), defined)) return false;
+            }
+            bool pending;
+            return callee(call->function, call->args, pending) || pending;
+        }
+        if (auto ifStmt = dynamic_cast<IfStmt*>(stmt)) {
+            if (!readable(ifStmt->condition.get(), defined)) return false;
+            if (!isCondition(typeOf(ifStmt->condition.get()))) return false;
+            std::vector<bool> thenDefined = defined, elseDefined = defined;
+            bool thenReturns, elseReturns;
+            if (!analyzeBlock(ifStmt->thenBranch, thenDefined, thenReturns)) return false;
+            if (!analyzeBlock(ifStmt->elseBranch, elseDefined, elseReturns)) return false;
+            for (size_t i = 0; i < defined.size(); ++i) {
+                if (thenReturns) defined[i] = elseDefined[i];
+                else if (elseReturns) defined[i] = thenDefined[i];
+                else defined[i] = thenDefined[i] && elseDefined[i];
+            }
+            returns = thenReturns && elseReturns;
+            return true;
+        }
+        if (auto whileLoop = dynamic_cast<WhileStmt*>(stmt)) {
+            if (!readable(whileLoop->condition.get(), defined)) return false;
+            if (!isCondition(typeOf(whileLoop->condition.get()))) return false;
+            std::vector<bool> bodyDefined = defined;
+            bool bodyReturns;
+            return analyzeBlock(whileLoop->body, bodyDefined, bodyReturns);
+        }
+        if (auto loop = dynamic_cast<ForStmt*>(stmt)) {
+            Expr* limit = rangeLimit(loop);
+            int slot = loop->ref.local;
+            if (!limit || slot < 0 || !readable(limit, defined)) return false;
+            JitType t = typeOf(limit);
+            if (t != JitType::Int && t != JitType::None) return false;
+            slots[slot] = join(slots[slot], JitType::Int);
+            if (slots[slot] == JitType::Invalid) return false;
+            defined[slot] = true;
+            std::vector<bool> bodyDefined = defined;
+            bool bodyReturns;
+            return analyzeBlock(loop->body, bodyDefined, bodyReturns);
+        }
+        if (auto ret = dynamic_cast<ReturnStmt*>(stmt)) {
+            JitType t = JitType::Nil;
+            if (ret->value) {
+                if (!readable(ret->value.get(), defined)) return false;
+                t = typeOf(ret->value.get());
+                if (!isCondition(t)) return false;
+            }
+            spec->ret = join(spec->ret, t);
+            returns = true;
+            return spec->ret != JitType::Invalid;
+        }
+        return false;
+    }
+
+    // 'for i in range(n)' dengan n int; collection lain (dan range start/step) tidak didukung
+    Expr* rangeLimit(ForStmt* loop) {
+        auto call = dynamic_cast<CallExpr*>(loop->collection.get());
+        if (!call || call->builtin != rangeId || rangeId < 0 || call->args.size() != 1) return nullptr;
+        return call->args[0].get();
+    }
+
+    // --- Codegen ---
+    void push(JitType t) {
+        if (t == JitType::Double) as.emit({0x66, 0x48, 0x0F, 0x7E, 0xC0}); // movq rax, xmm0
+        as.emit({0x50});
+        depth++;
+    }
+
+    void genValue(Expr* expr, JitType want) {
+        JitType t = typeOf(expr);
+        genRaw(expr, t);
+        if (want == JitType::Double && t == JitType::Int) as.emit({0xF2, 0x0F, 0x2A, 0xC0}); // cvtsi2sd xmm0, eax
+    }
+
+    void genRaw(Expr* expr, JitType t) {
+        if (!isValue(t) && t != JitType::Nil) {
+            failed = true;
+            return;
+        }
+        if (auto num = dynamic_cast<NumberExpr*>(expr)) {
+            as.emit({0xB8});
+            as.imm32(num->value);
+            return;
+        }
+        if (auto flt = dynamic_cast<FloatExpr*>(expr)) {
+            uint64_t bits;
+            std::memcpy(&bits, &flt->value, 8);
+            as.emit({0x48, 0xB8});
+            as.imm64(bits);
+            as.emit({0x66, 0x48, 0x0F, 0x6E, 0xC0}); // movq xmm0, rax
+            return;
+        }
+        if (auto bl = dynamic_cast<BoolExpr*>(expr)) {
+            as.emit({0xB8});
+            as.imm32(bl->value ? 1 : 0);
+            return;
+        }
+        if (auto var = dynamic_cast<VariableExpr*>(expr)) {
+            if (t == JitType::Double) as.slotOp({0xF2, 0x0F, 0x10, 0x85}, var->ref.local); // movsd xmm0, [slot]
+            else as.slotOp({0x8B, 0x85}, var->ref.local);                                 // mov eax, [slot]
+            return;
+        }
+        if (auto bin = dynamic_cast<BinaryExpr*>(expr)) {
+            genBinary(bin);
+            return;
+        }
+        if (auto call = dynamic_cast<CallExpr*>(expr)) {
+            genCall(call->function, call->args);
+            if (t == JitType::Double) as.emit({0x66, 0x48, 0x0F, 0x6E, 0xC0});
+            return;
+        }
+        failed = true;
+    }
+
+    void genBinary(BinaryExpr* bin) {
+        bool isInt = typeOf(bin->lhs.get()) == JitType::Int && typeOf(bin->rhs.get()) == JitType::Int;
+        JitType operand = isInt ? JitType::Int : JitType::Double;
+        genValue(bin->lhs.get(), operand);
+        push(operand);
+        genValue(bin->rhs.get(), operand);
+        if (isInt) {
+            as.emit({0x89, 0xC1, 0x58}); // mov ecx, eax; pop rax
+            depth--;
+            switch (bin->op) {
+                case '+': as.emit({0x01, 0xC8}); break;
+                case '-': as.emit({0x29, 0xC8}); break;
+                case '*': as.emit({0x0F, 0xAF, 0xC1}); break;
+                // (r != 0) ? l / r : 0
+                case '/': as.emit({0x85, 0xC9, 0x74, 0x05, 0x99, 0xF7, 0xF9, 0xEB, 0x02, 0x31, 0xC0}); break;
+                case '<': as.emit({0x39, 0xC8, 0x0F, 0x9C, 0xC0, 0x0F, 0xB6, 0xC0}); break;
+                case '>': as.emit({0x39, 0xC8, 0x0F, 0x9F, 0xC0, 0x0F, 0xB6, 0xC0}); break;
+                case '=': as.emit({0x39, 0xC8, 0x0F, 0x94, 0xC0, 0x0F, 0xB6, 0xC0}); break;
+            }
+            return;
+        }
+        // movapd xmm1, xmm0; pop rax; movq xmm0, rax
+        as.emit({0x66, 0x0F, 0x28, 0xC8, 0x58, 0x66, 0x48, 0x0F, 0x6E, 0xC0});
+        depth--;
+        switch (bin->op) {
+            case '+': as.emit({0xF2, 0x0F, 0x58, 0xC1}); break;
+            case '-': as.emit({0xF2, 0x0F, 0x5C, 0xC1}); break;
+            case '*': as.emit({0xF2, 0x0F, 0x59, 0xC1}); break;
+            // (r != 0.0) ? l / r : 0.0 (NaN != 0.0 tetap dibagi)
+            case '/':
+                as.emit({0x66, 0x0F, 0x57, 0xD2, 0x66, 0x0F, 0x2E, 0xCA, 0x75, 0x08, 0x7A, 0x06,
+                         0x66, 0x0F, 0x57, 0xC0, 0xEB, 0x04, 0xF2, 0x0F, 0x5E, 0xC1});
+                break;
+            // ucomisd + seta: unordered (NaN) menghasilkan false seperti di C++
+            case '<': as.emit({0x66, 0x0F, 0x2E, 0xC8, 0x0F, 0x97, 0xC0, 0x0F, 0xB6, 0xC0}); break;
+            case '>': as.emit({0x66, 0x0F, 0x2E, 0xC1, 0x0F, 0x97, 0xC0, 0x0F, 0xB6, 0xC0}); break;
+            case '=':
+                as.emit({0x66, 0x0F, 0x2E, 0xC1, 0x0F, 0x94, 0xC0, 0x0F, 0x9B, 0xC1, 0x20, 0xC8, 0x0F, 0xB6, 0xC0});
+                break;
+        }
+    }
+
+    // Argumen ditulis ke area di stack (rdi menunjuk ke argumen 0), hasil di rax
+    void genCall(int function, const std::vector<std::unique_ptr<Expr>>& args) {
+        bool pending;
+        JitSpec* target = callee(function, args, pending);
+        if (!target) {
+            failed = true;
+            return;
+        }
+        int reserve = (int)args.size();
+        if ((depth + reserve) % 2) reserve++;
+        if (reserve) {
+            as.emit({0x48, 0x81, 0xEC});
+            as.imm32(reserve * 8);
+            depth += reserve;
+        }
+        for (size_t i = 0; i < args.size(); ++i) {
+            genValue(args[i].get(), target->params[i]);
+            if (target->params[i] == JitType::Double) as.emit({0xF2, 0x0F, 0x11, 0x84, 0x24}); // movsd [rsp+d], xmm0
+            else as.emit({0x48, 0x89, 0x84, 0x24});                                             // mov [rsp+d], rax
+            as.imm32((int32_t)(8 * i));
+        }
+        as.emit({0x48, 0x89, 0xE7}); // mov rdi, rsp
+        if (target == spec) {
+            as.jumpTo({0xE8}, 0); // rekursi ke awal fungsi ini
+        } else {
+            as.emit({0x48, 0xB8});
+            as.imm64((uint64_t)(uintptr_t)target->code);
+            as.emit({0xFF, 0xD0}); // call rax
+        }
+        // Callee kena batas stack: hasilnya tidak berarti, keluar juga
+        as.emit({0x48, 0xB9});
+        as.imm64((uint64_t)(uintptr_t)&jit.overflow); // mov rcx, &overflow
+        as.emit({0x48, 0x83, 0x39, 0x00});            // cmp qword [rcx], 0
+        as.emit({0x74, 0x02, 0xC9, 0xC3});            // je +2; leave; ret
+        if (reserve) {
+            as.emit({0x48, 0x81, 0xC4});
+            as.imm32(reserve * 8);
+            depth -= reserve;
+        }
+    }
+
+    // 'return f(...)' ke spesialisasi ini sendiri jadi loop: argumen dihitung dulu ke stack,
+    // lalu ditimpa ke slot parameter dan lompat ke awal body. Tail call ke fungsi lain tidak
+    // di-JIT, karena call native akan menumpuk stack C yang tidak dibatasi interpreter.
+    void genTailCall(CallExpr* call) {
+        bool pending;
+        if (callee(call->function, call->args, pending) != spec) {
+            failed = true;
+            return;
+        }
+        int reserve = (int)call->args.size();
+        if ((depth + reserve) % 2) reserve++;
+        if (reserve) {
+            as.emit({0x48, 0x81, 0xEC});
+            as.imm32(reserve * 8);
+        }
+        depth += reserve;
+        for (size_t i = 0; i < call->args.size(); ++i) {
+            genValue(call->args[i].get(), spec->params[i]);
+            if (spec->params[i] == JitType::Double) as.emit({0xF2, 0x0F, 0x11, 0x84, 0x24}); // movsd [rsp+d], xmm0
+            else as.emit({0x48, 0x89, 0x84, 0x24});                                           // mov [rsp+d], rax
+            as.imm32((int32_t)(8 * i));
+        }
+        depth -= reserve;
+        for (size_t i = 0; i < call->args.size(); ++i) {
+            as.emit({0x48, 0x8B, 0x84, 0x24}); // mov rax, [rsp+d]
+            as.imm32((int32_t)(8 * i));
+            as.slotOp({0x48, 0x89, 0x85}, (int)i);
+        }
+        if (reserve) {
+            as.emit({0x48, 0x81, 0xC4});
+            as.imm32(reserve * 8);
+        }
+        as.jumpTo({0xE9}, bodyStart);
+    }
+
+    // Lompat kalau kondisi falsy (semantik isTruthy); hasilnya posisi operand untuk di-patch
+    size_t genJumpIfFalse(Expr* cond) {
+        JitType t = typeOf(cond);
+        genValue(cond, t);
+        if (t == JitType::Double) {
+            // xorpd xmm1, xmm1; ucomisd xmm0, xmm1; jp +6 (NaN truthy)
+            as.emit({0x66, 0x0F, 0x57, 0xC9, 0x66, 0x0F, 0x2E, 0xC1, 0x7A, 0x06});
+        } else {
+            as.emit({0x85, 0xC0}); // test eax, eax
+        }
+        return as.jump({0x0F, 0x84}); // je
+    }
+
+    bool genBlock(const std::vector<std::unique_ptr<Stmt>>& body, bool& returns) {
+        returns = false;
+        for (auto& s : body) {
+            genStmt(s.get(), returns);
+            if (failed) return false;
+            if (returns) break;
+        }
+        return true;
+    }
+
+    void storeSlot(int slot, JitType t) {
+        if (t == JitType::Double) as.slotOp({0xF2, 0x0F, 0x11, 0x85}, slot); // movsd [slot], xmm0
+        else as.slotOp({0x89, 0x85}, slot);                                  // mov [slot], eax
+    }
+
+    void genStmt(Stmt* stmt, bool& returns) {
+        if (auto set = dynamic_cast<SetStmt*>(stmt)) {
+            JitType t = slots[set->ref.local];
+            genValue(set->expression.get(), t);
+            storeSlot(set->ref.local, t);
+            return;
+        }
+        if (auto up = dynamic_cast<UpdateStmt*>(stmt)) {
+            // Interpreter hanya menaikkan int
+            if (slots[up->ref.local] == JitType::Int) {
+                as.slotOp({0x83, 0x85}, up->ref.local);
+                as.emit({0x01});
+            }
+            return;
+        }
+        if (auto exprStmt = dynamic_cast<ExprStmt*>(stmt)) {
+            genRaw(exprStmt->expression.get(), typeOf(exprStmt->expression.get()));
+            return;
+        }
+        if (auto call = dynamic_cast<CallStmt*>(stmt)) {
+            genCall(call->function, call->args);
+            return;
+        }
+        if (auto ifStmt = dynamic_cast<IfStmt*>(stmt)) {
+            size_t elseJump = genJumpIfFalse(ifStmt->condition.get());
+            bool thenReturns, elseReturns = false;
+            genBlock(ifStmt->thenBranch, thenReturns);
+            if (ifStmt->elseBranch.empty()) {
+                as.patch(elseJump);
+            } else {
+                size_t endJump = as.jump({0xE9});
+                as.patch(elseJump);
+                genBlock(ifStmt->elseBranch, elseReturns);
+                as.patch(endJump);
+            }
+            returns = thenReturns && elseReturns;
+            return;
+        }
+        if (auto whileLoop = dynamic_cast<WhileStmt*>(stmt)) {
+            size_t start = as.code.size();
+            size_t exitJump = genJumpIfFalse(whileLoop->condition.get());
+            bool bodyReturns;
+            genBlock(whileLoop->body, bodyReturns);
+            as.jumpTo({0xE9}, start);
+            as.patch(exitJump);
+            return;
+        }
+        if (auto loop = dynamic_cast<ForStmt*>(stmt)) {
+            // Counted loop tanpa list: iterator = 0 dulu (define), lalu 0..n-1
+            int iter = loop->ref.local, counter = nextSlot++, limit = nextSlot++;
+            genValue(rangeLimit(loop), JitType::Int);
+            storeSlot(limit, JitType::Int);
+            as.slotOp({0xC7, 0x85}, iter);
+            as.imm32(0);
+            as.slotOp({0xC7, 0x85}, counter);
+            as.imm32(0);
+            size_t start = as.code.size();
+            as.slotOp({0x8B, 0x85}, counter);
+            as.slotOp({0x3B, 0x85}, limit); // cmp eax, [limit]
+            size_t exitJump = as.jump({0x0F, 0x8D}); // jge
+            storeSlot(iter, JitType::Int);
+            bool bodyReturns;
+            genBlock(loop->body, bodyReturns);
+            as.slotOp({0x83, 0x85}, counter);
+            as.emit({0x01});
+            as.jumpTo({0xE9}, start);
+            as.patch(exitJump);
+            return;
+        }
+        if (auto ret = dynamic_cast<ReturnStmt*>(stmt)) {
+            if (ret->tail) {
+                genTailCall(static_cast<CallExpr*>(ret->value.get()));
+                returns = true;
+                return;
+            }
+            if (spec->ret == JitType::Nil) {
+                if (ret->value) genRaw(ret->value.get(), JitType::Nil); // tetap dievaluasi
+                as.emit({0x31, 0xC0});
+            } else {
+                genValue(ret->value.get(), spec->ret);
+                if (spec->ret == JitType::Double) as.emit({0x66, 0x48, 0x0F, 0x7E, 0xC0});
+            }
+            as.emit({0xC9, 0xC3}); // leave; ret
+            returns = true;
+            return;
+        }
+        failed = true;
+    }
+};
+
+} // namespace
+
+bool Jit::supported() {
+#ifdef LINK_JIT_X64
+    return true;
+#else
+    return false;
+#endif
+}
+
+Jit::~Jit() {
+    invalidate();
+}
+
+void Jit::invalidate() {
+    for (auto& entry : functions) entry->fn->jit = nullptr;
+    functions.clear();
+#ifdef LINK_JIT_X64
+    for (auto& page : pages) munmap(page.first, page.second);
+#endif
+    pages.clear();
+}
+
+JitFunction* Jit::entryFor(FuncDecl* fn) {
+    if (fn->jit) return fn->jit;
+    auto entry = std::make_unique<JitFunction>();
+    entry->fn = fn;
+    entry->hasLoop = containsLoop(fn->body);
+    fn->jit = entry.get();
+    functions.push_back(std::move(entry));
+    return fn->jit;
+}
+
+void* Jit::install(const std::vector<uint8_t>& code) {
+#ifdef LINK_JIT_X64
+    size_t size = (code.size() + 4095) & ~(size_t)4095;
+    void* mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) return nullptr;
+    std::memcpy(mem, code.data(), code.size());
+    if (mprotect(mem, size, PROT_READ | PROT_EXEC) != 0) {
+        munmap(mem, size);
+        return nullptr;
+    }
+    pages.push_back({mem, size});
+    return mem;
+#else
+    (void)code;
+    return nullptr;
+#endif
+}
+
+JitSpec* Jit::specialize(FuncDecl* fn, const JitType* params, size_t count) {
+    JitFunction* entry = entryFor(fn);
+    for (auto& spec : entry->specs) {
+        if (std::equal(spec->params.begin(), spec->params.end(), params)) return spec.get();
+    }
+    if ((int)entry->specs.size() >= MAX_SPECS) return nullptr;
+
+    entry->specs.push_back(std::make_unique<JitSpec>());
+    JitSpec* spec = entry->specs.back().get();
+    spec->params.assign(params, params + count);
+    spec->compiling = true;
+    std::vector<uint8_t> code;
+    JitCompiler compiler(*this, registry, fn, spec);
+    if (supported() && compiler.compile(code)) spec->code = install(code);
+    spec->compiling = false;
+    return spec;
+}
+
+bool Jit::call(FuncDecl* fn, const Obj* args, Obj& result) {
+#ifdef LINK_JIT_X64
+    JitFunction* entry = entryFor(fn);
+    if (entry->calls < CALL_THRESHOLD && !entry->hasLoop) {
+        entry->calls++;
+        return false;
+    }
+    if (entry->cooldown > 0) {
+        entry->cooldown--;
+        return false;
+    }
+    size_t count = fn->params.size();
+    if (count > (size_t)MAX_PARAMS) return false;
+
+    JitType types[MAX_PARAMS];
+    uint64_t raw[MAX_PARAMS];
+    for (size_t i = 0; i < count; ++i) {
+        if (args[i].isInt()) {
+            types[i] = JitType::Int;
+            raw[i] = (uint32_t)args[i].asInt();
+        } else if (args[i].isDouble()) {
+            types[i] = JitType::Double;
+            double d = args[i].asDouble();
+            std::memcpy(&raw[i], &d, 8);
+        } else {
+            return false;
+        }
+    }
+
+    JitSpec* spec = specialize(fn, types, count);
+    if (!spec || !spec->code) return false;
+
+    if (!stackFloor) stackFloor = ::stackFloor();
+    overflow = 0;
+    uint64_t out = reinterpret_cast<uint64_t (*)(const uint64_t*)>(spec->code)(raw);
+    if (overflow) {
+        // Kode native tidak punya efek samping, jadi panggilan ini cukup diulang interpreter.
+        // Rekursi di dalamnya dicoba native lagi setelah 'cooldown' panggilan (makin jarang
+        // kalau terus gagal), supaya tidak tiap level menyelam sampai batas stack.
+        entry->backoff = std::min(std::max(entry->backoff * 2, 64), (int)MAX_BACKOFF);
+        entry->cooldown = entry->backoff;
+        return false;
+    }
+    switch (spec->ret) {
+        case JitType::Int: result = Obj((int)(uint32_t)out); break;
+        case JitType::Bool: result = Obj((out & 1) != 0); break;
+        case JitType::Double: {
+            double d;
+            std::memcpy(&d, &out, 8);
+            result = Obj(d);
+            break;
+        }
+        default: result = Obj(); break;
+    }
+    return true;
+#else
+    (void)fn; (void)args; (void)result;
+    return false;
+#endif
+}
@@ -1,24 +1,116 @@
 #include "lexer.h"
 #include <cctype>
+#include <charconv>
+#include <cstdint>
 #include <stdexcept>
+#include <string_view>
 #include <unordered_map>
 
-static const std::unordered_map<std::string, TokenType> keywords = {
-    {"app", TokenType::APP},            {"for", TokenType::FOR},            {"while", TokenType::WHILE},
-    {"if", TokenType::IF},              {"elif", TokenType::ELIF},          {"else", TokenType::ELSE},
-    {"window", TokenType::WINDOW},      {"func", TokenType::FUNC},          {"return", TokenType::RETURN},  
-    {"expose", TokenType::EXPOSE},      {"connect", TokenType::CONNECT},    {"import", TokenType::IMPORT}, 
-   
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Keyword lewat perfect hash yang dicek saat kompilasi: (panjang, huruf pertama, huruf terakhir)
+// -> slot unik di tabel 64 entri, lalu satu perbandingan string.
+struct Keyword {
+    std::string_view text;
+    TokenType type;
+};
+
+static constexpr Keyword keywordList[] = {
+    {"app", TokenType::APP},         {"for", TokenType::FOR},         {"while", TokenType::WHILE},
+    {"if", TokenType::IF},           {"elif", TokenType::ELIF},       {"else", TokenType::ELSE},
+    {"window", TokenType::WINDOW},   {"func", TokenType::FUNC},       {"return", TokenType::RETURN},
+    {"expose", TokenType::EXPOSE},   {"connect", TokenType::CONNECT}, {"import", TokenType::IMPORT},
+
     {"try", TokenType::TRY}, {"catch", TokenType::CATCH},
-    {"class", TokenType::CLASS}, {"init", TokenType::INIT}, {"new", TokenType::NEW}, {"this", TokenType::THIS}, 
+    {"class", TokenType::CLASS}, {"init", TokenType::INIT}, {"new", TokenType::NEW}, {"this", TokenType::THIS},
+
+    {"package", TokenType::PACKAGE}, {"sh", TokenType::SH},
+    {"in", TokenType::IN},           {"set", TokenType::SET},
+    {"true", TokenType::TRUE},       {"false", TokenType::FALSE},
+    {"clear", TokenType::CLEAR},     {"cls", TokenType::CLS}
+};
+
+static constexpr size_t KEYWORD_SLOTS = 64;
 
-    {"package", TokenType::PACKAGE},    {"sh", TokenType::SH},
-    {"in", TokenType::IN},              {"set", TokenType::SET},
-    {"true", TokenType::TRUE},          {"false", TokenType::FALSE}, 
-    {"clear", TokenType::CLEAR},        {"cls", TokenType::CLS} 
+static constexpr size_t keywordSlot(std::string_view word) {
+    return (word.size() * 3 + static_cast<unsigned char>(word[0])
+            + static_cast<unsigned char>(word[word.size() - 1]) * 19) & (KEYWORD_SLOTS - 1);
+}
+
+struct KeywordTable {
+    Keyword slots[KEYWORD_SLOTS] = {};
+    bool perfect = true;
 };
 
-Lexer::Lexer(const std::string& source) : src(source), pos(0), line(1), column(1) {
+static constexpr KeywordTable buildKeywordTable() {
+    KeywordTable table;
+    for (const Keyword& keyword : keywordList) {
+        Keyword& slot = table.slots[keywordSlot(keyword.text)];
+        if (!slot.text.empty()) table.perfect = false;
+        slot = keyword;
+    }
+    return table;
+}
+
+static constexpr KeywordTable keywords = buildKeywordTable();
+static_assert(keywords.perfect, "keywordSlot() bentrok: ganti konstanta hash setelah menambah keyword");
+
+static TokenType keywordType(std::string_view word) {
+    const Keyword& slot = keywords.slots[keywordSlot(word)];
+    return slot.text == word ? slot.type : TokenType::IDENTIFIER;
+}
+
+// Scan run karakter sekelas (tidak pernah melewati '\n'). Versi SSE2 memproses 16 byte
+// sekaligus (bit mask = byte yang masih termasuk run); sisanya, dan platform tanpa SSE2,
+// lewat loop skalar.
+enum class Run { Ident, Blank, Comment, String };
+
+template <Run kind>
+static bool inRun(char c) {
+    if constexpr (kind == Run::Ident) return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    if constexpr (kind == Run::Blank) return c == ' ' || c == '\t' || c == '\r';
+    if constexpr (kind == Run::Comment) return c != '\n' && c != '\0';
+    if constexpr (kind == Run::String) return c != '"' && c != '\n' && c != '\0';
+}
+
+#if defined(__SSE2__)
+template <Run kind>
+static unsigned runMask(__m128i v) {
+    if constexpr (kind == Run::Ident) {
+        __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20)); // byte >= 0x80 tetap negatif
+        __m128i alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+        __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+        __m128i under = _mm_cmpeq_epi8(v, _mm_set1_epi8('_'));
+        return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(alpha, digit), under));
+    }
+    if constexpr (kind == Run::Blank) {
+        __m128i space = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+        __m128i tab = _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'));
+        __m128i cr = _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'));
+        return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(space, tab), cr));
+    }
+    __m128i stop = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_setzero_si128()));
+    if constexpr (kind == Run::String) stop = _mm_or_si128(stop, _mm_cmpeq_epi8(v, _mm_set1_epi8('"')));
+    return ~_mm_movemask_epi8(stop) & 0xFFFF;
+}
+#endif
+
+template <Run kind>
+static const char* scanRun(const char* p, const char* end) {
+#if defined(__SSE2__)
+    while (end - p >= 16) {
+        unsigned mask = runMask<kind>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+        if (mask != 0xFFFF) return p + __builtin_ctz(~mask);
+        p += 16;
+    }
+#endif
+    while (p < end && inRun<kind>(*p)) p++;
+    return p;
+}
+
+Lexer::Lexer(std::string_view source) : src(source), pos(0), line(1), column(1) {
     indentStack.push_back(0);
 }
 
@@ -27,6 +119,12 @@ char Lexer::peek() const {
     return src[pos];
 }
 
+void Lexer::skipTo(const char* stop) {
+    size_t next = stop - src.data();
+    column += static_cast<int>(next - pos);
+    pos = next;
+}
+
 char Lexer::advance() {
     char c = peek();
     pos++; column++;
@@ -39,35 +137,45 @@ bool Lexer::match(char expected) {
     return true;
 }
 
-Token Lexer::makeToken(TokenType type, const std::string& value) {
-    return Token{type, value, line, column};
+Token Lexer::makeToken(TokenType type, size_t start, int startCol) {
+    Token token;
+    token.type = type;
+    token.offset = static_cast<uint32_t>(start);
+    token.length = static_cast<uint32_t>(pos - start);
+    token.line = line;
+    token.column = startCol;
+    token.floatValue = 0;
+    return token;
+}
+
+Token Lexer::symbol(TokenType type, size_t width) {
+    size_t start = pos;
+    int startCol = column;
+    while (width--) advance();
+    return makeToken(type, start, startCol);
 }
 
 void Lexer::skipWhitespace() {
-    while (peek() == ' ' || peek() == '\t' || peek() == '\r') {
-        advance();
-    }
+    skipTo(scanRun<Run::Blank>(src.data() + pos, src.data() + src.size()));
 }
 
 Token Lexer::identifier() {
+    size_t start = pos;
     int startCol = column;
-    std::string value;
-    while (std::isalnum(peek()) || peek() == '_') value += advance();
-    auto it = keywords.find(value);
-    if (it != keywords.end()) return Token{it->second, value, line, startCol};
-    return Token{TokenType::IDENTIFIER, value, line, startCol};
+    skipTo(scanRun<Run::Ident>(src.data() + pos, src.data() + src.size()));
+    return makeToken(keywordType(src.substr(start, pos - start)), start, startCol);
 }
 
+// Token STRING/CHAR menunjuk isi di antara tanda kutip
 Token Lexer::stringLiteral() {
     int startCol = column;
-    std::string value;
     advance(); 
-    while (peek() != '"' && peek() != '\0') {
-        if (peek() == '\n') throw std::runtime_error("Unterminated string");
-        value += advance();
-    }
+    size_t start = pos;
+    skipTo(scanRun<Run::String>(src.data() + pos, src.data() + src.size()));
+    if (peek() == '\n') throw std::runtime_error("Unterminated string");
+    Token token = makeToken(TokenType::STRING, start, startCol);
     if (!match('"')) throw std::runtime_error("Unterminated string");
-    return Token{TokenType::STRING, value, line, startCol};
+    return token;
 }
 
 void Lexer::handleIndentation(std::vector<Token>& tokens) {
@@ -89,24 +197,41 @@ void Lexer::handleIndentation(std::vector<Token>& tokens) {
 }
 
 void Lexer::skipComment() {
-    while (peek() != '\n' && peek() != '\0') advance();
+    skipTo(scanRun<Run::Comment>(src.data() + pos, src.data() + src.size()));
 }
 
 Token Lexer::number() {
+    size_t start = pos;
     int startCol = column;
-    std::string value;
     bool isFloat = false;
-    while (std::isdigit(peek())) value += advance();
+    while (std::isdigit(peek())) advance();
     if (peek() == '.') {
-        isFloat = true; value += advance();
-        while (std::isdigit(peek())) value += advance();
+        isFloat = true; advance();
+        while (std::isdigit(peek())) advance();
     }
-    return Token{isFloat ? TokenType::TOKEN_FLOAT : TokenType::TOKEN_NUM, value, line, startCol}; 
+    Token token = makeToken(isFloat ? TokenType::TOKEN_FLOAT : TokenType::TOKEN_NUM, start, startCol);
+    const char* first = src.data() + start;
+    const char* last = src.data() + pos;
+    std::from_chars_result parsed = isFloat ? std::from_chars(first, last, token.floatValue)
+                                            : std::from_chars(first, last, token.intValue);
+    if (parsed.ec == std::errc::result_out_of_range) throw std::runtime_error("Number out of range: " + std::string(first, last));
+    return token;
 }
 
 std::vector<Token> Lexer::tokenize() {
     std::vector<Token> tokens;
-    while (pos < src.size()) {
+    tokens.reserve(src.size() / 4 + 16);
+    scan(tokens, SIZE_MAX);
+    return tokens;
+}
+
+void Lexer::scan(std::vector<Token>& tokens, size_t want) {
+    while (tokens.size() < want && !finished) {
+        if (pos >= src.size()) {
+            tokens.push_back(makeToken(TokenType::EOF_TOKEN));
+            finished = true;
+            break;
+        }
         char c = peek();
         if (c == '#') { skipComment(); continue; }
         if (c == '\n') { advance(); tokens.push_back(makeToken(TokenType::NEWLINE)); line++; column = 1; handleIndentation(tokens); continue; }
@@ -116,50 +241,45 @@ std::vector<Token> Lexer::tokenize() {
         if (c == '"') { tokens.push_back(stringLiteral()); continue; }
         if (c == '\'') {
             int startCol = column;
-            std::string value;
             advance(); 
-            while (peek() != '\'' && peek() != '\0') value += advance();
+            size_t start = pos;
+            while (peek() != '\'' && peek() != '\0') advance();
+            Token token = makeToken(pos - start == 1 ? TokenType::CHAR : TokenType::STRING, start, startCol);
             if (!match('\'')) throw std::runtime_error("Unterminated quote");
-            if (value.length() == 1) tokens.push_back(Token{TokenType::CHAR, value, line, startCol});
-            else tokens.push_back(Token{TokenType::STRING, value, line, startCol});
+            tokens.push_back(token);
             continue;
         }
         
-        if (c == '(') { advance(); tokens.push_back(makeToken(TokenType::LPAREN, "(")); continue; }
-        if (c == ')') { advance(); tokens.push_back(makeToken(TokenType::RPAREN, ")")); continue; }
-        if (c == '[') { advance(); tokens.push_back(makeToken(TokenType::LBRACKET, "[")); continue; }
-        if (c == ']') { advance(); tokens.push_back(makeToken(TokenType::RBRACKET, "]")); continue; }
-        if (c == '{') { advance(); tokens.push_back(makeToken(TokenType::LBRACE, "{")); continue; }
-        if (c == '}') { advance(); tokens.push_back(makeToken(TokenType::RBRACE, "}")); continue; }
-        if (c == '.') { advance(); tokens.push_back(makeToken(TokenType::DOT, ".")); continue; }
-        if (c == ',') { advance(); tokens.push_back(makeToken(TokenType::COMMA, ",")); continue; }
-        if (c == ':') { advance(); tokens.push_back(makeToken(TokenType::COLON, ":")); continue; }
-
-        if (c == '*') { advance(); tokens.push_back(makeToken(TokenType::STAR, "*")); continue; }
-        if (c == '/') { advance(); tokens.push_back(makeToken(TokenType::SLASH, "/")); continue; }
-        if (c == '<') { advance(); tokens.push_back(makeToken(TokenType::LT, "<")); continue; }
-        if (c == '>') { advance(); tokens.push_back(makeToken(TokenType::GT, ">")); continue; }
+        if (c == '(') { tokens.push_back(symbol(TokenType::LPAREN, 1)); continue; }
+        if (c == ')') { tokens.push_back(symbol(TokenType::RPAREN, 1)); continue; }
+        if (c == '[') { tokens.push_back(symbol(TokenType::LBRACKET, 1)); continue; }
+        if (c == ']') { tokens.push_back(symbol(TokenType::RBRACKET, 1)); continue; }
+        if (c == '{') { tokens.push_back(symbol(TokenType::LBRACE, 1)); continue; }
+        if (c == '}') { tokens.push_back(symbol(TokenType::RBRACE, 1)); continue; }
+        if (c == '.') { tokens.push_back(symbol(TokenType::DOT, 1)); continue; }
+        if (c == ',') { tokens.push_back(symbol(TokenType::COMMA, 1)); continue; }
+        if (c == ':') { tokens.push_back(symbol(TokenType::COLON, 1)); continue; }
+
+        if (c == '*') { tokens.push_back(symbol(TokenType::STAR, 1)); continue; }
+        if (c == '/') { tokens.push_back(symbol(TokenType::SLASH, 1)); continue; }
+        if (c == '<') { tokens.push_back(symbol(TokenType::LT, 1)); continue; }
+        if (c == '>') { tokens.push_back(symbol(TokenType::GT, 1)); continue; }
         
         if (c == '=') { 
-            advance(); 
-            if (match('=')) tokens.push_back(makeToken(TokenType::EQ_EQ, "=="));
-            else tokens.push_back(makeToken(TokenType::ASSIGN, "=")); 
+            if (src.compare(pos, 2, "==") == 0) tokens.push_back(symbol(TokenType::EQ_EQ, 2));
+            else tokens.push_back(symbol(TokenType::ASSIGN, 1)); 
             continue; 
         }
         if (c == '+') {
-            advance();
-            if (match('+')) tokens.push_back(makeToken(TokenType::PLUS_PLUS, "++"));
-            else tokens.push_back(makeToken(TokenType::PLUS, "+")); 
+            if (src.compare(pos, 2, "++") == 0) tokens.push_back(symbol(TokenType::PLUS_PLUS, 2));
+            else tokens.push_back(symbol(TokenType::PLUS, 1)); 
             continue;
         }
         if (c == '-') {
-            advance();
-            if (match('>')) tokens.push_back(makeToken(TokenType::ARROW, "->"));
-            else tokens.push_back(makeToken(TokenType::MINUS, "-")); 
+            if (src.compare(pos, 2, "->") == 0) tokens.push_back(symbol(TokenType::ARROW, 2));
+            else tokens.push_back(symbol(TokenType::MINUS, 1)); 
             continue;
         }
         throw std::runtime_error("Unknown char: " + std::string(1, c));
     }
-    tokens.push_back(makeToken(TokenType::EOF_TOKEN));
-    return tokens;
 }
@@ -22,16 +22,18 @@ namespace SysString {
         return str;
     }
 
-    std::vector<std::string> split(std::string str, const std::string& delimiter) {
+    std::vector<std::string> split(const std::string& str, const std::string& delimiter) {
         std::vector<std::string> list;
-        size_t pos = 0;
-        std::string token;
-        while ((pos = str.find(delimiter)) != std::string::npos) {
-            token = str.substr(0, pos);
-            list.push_back(token);
-            str.erase(0, pos + delimiter.length());
+        if (delimiter.empty()) {
+            list.push_back(str);
+            return list;
         }
-        list.push_back(str); // Sisa string terakhir
+        size_t start = 0, pos;
+        while ((pos = str.find(delimiter, start)) != std::string::npos) {
+            list.emplace_back(str, start, pos - start);
+            start = pos + delimiter.length();
+        }
+        list.emplace_back(str, start); // Sisa string terakhir
         return list;
     }
 
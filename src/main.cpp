@@ -1,11 +1,15 @@
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <string>
 #include <vector>
 #include "lexer.h"
 #include "parser.h"
+#include "optimizer.h"
 #include "runtime.cpp" 
 #include "help.h"
+#include "os.h"
+#include "astcache.h"
 
 bool isBlockStart(const std::string& line) {
     size_t start = line.find_first_not_of(" \t");
@@ -33,12 +37,11 @@ bool isBlockStart(const std::string& line) {
     return false;
 }
 
-void run(Runtime& runtime, const std::string& source, bool isDebug) {
+// path = file script (AST-nya boleh diambil dari / ditulis ke cache), kosong untuk REPL
+// false kalau terjadi error (parse atau runtime)
+bool run(Runtime& runtime, std::string_view source, bool isDebug, const std::string& path = "") {
     try {
-        Lexer lexer(source);
-        auto tokens = lexer.tokenize();
-        Parser parser(tokens);
-        auto program = parser.parse(); 
+        auto program = AstCache::compile(path, source);
 
         if (isDebug) {
             std::cout << "\n--- DEBUG: AST STRUCTURE ---\n";
@@ -46,30 +49,104 @@ void run(Runtime& runtime, const std::string& source, bool isDebug) {
             std::cout << "----------------------------\n";
         }
 
-        runtime.execute(std::move(program)); 
+        return runtime.execute(std::move(program), path); 
 
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
+        return false;
     }
 }
 
-int main(int argc, char** argv) {
-    Runtime runtime; 
+// --stream: token diambil saat dibutuhkan dan tiap statement top-level langsung dijalankan
+// lalu dilepas, jadi output muncul segera dan memori tidak tumbuh dengan panjang script.
+void runStreaming(Runtime& runtime, std::string_view source, bool isDebug) {
+    try {
+        Lexer lexer(source);
+        Parser parser(lexer, source);
+        while (auto program = parser.parseNext()) {
+            Optimizer().optimize(*program);
+            if (isDebug) program->print();
+            if (!runtime.executeStreamed(std::move(program))) break;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+}
+
+// --bench-lex: ukur throughput Lexer saja (tanpa parse/eksekusi). Source diulang sampai
+// minimal 8 MB lalu di-tokenize berulang kali selama minimal 1 detik.
+void benchLexer(std::string_view file) {
+    std::string source(file);
+    if (!source.empty() && source.back() != '\n') source += '\n';
+    std::string unit = source;
+    while (!unit.empty() && source.size() < 8 * 1024 * 1024) source += unit;
+    try {
+        size_t tokens = 0;
+        int rounds = 0;
+        double elapsed = 0;
+        auto start = std::chrono::steady_clock::now();
+        do {
+            Lexer lexer(source);
+            tokens = lexer.tokenize().size();
+            rounds++;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (elapsed < 1.0 || rounds < 3);
+        double megabytes = static_cast<double>(source.size()) * rounds / (1024.0 * 1024.0);
+        std::cout << "Lexer: " << source.size() << " bytes, " << tokens << " tokens, " << rounds << " rounds, "
+                  << (megabytes / elapsed) << " MB/s" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+}
 
+int main(int argc, char** argv) {
     if (argc == 2 && std::string(argv[1]) == "--help") {
         printHelp();
         return 0;
     }
 
     bool debugMode = false;
+    Engine engine = Engine::Walker;
+    bool useJit = false;
+    bool lexBench = false;
+    bool streaming = false;
+    std::string snapshotPath, imagePath; // --snapshot <out.img>, --image <in.img>
+    int flagCount = 0;
     for(int i=1; i<argc; i++) {
-        if(std::string(argv[i]) == "--debug") {
+        std::string arg = argv[i];
+        if (arg == "--debug") {
             debugMode = true;
-            break;
+            flagCount++;
+        } else if (arg.rfind("--engine=", 0) == 0) {
+            std::string name = arg.substr(9);
+            if (name == "vm") engine = Engine::VM;
+            else if (name != "walker") {
+                std::cout << "Error: Unknown engine '" << name << "'. Use --engine=walker or --engine=vm." << std::endl;
+                return 1;
+            }
+            flagCount++;
+        } else if (arg == "--jit") {
+            useJit = true;
+            flagCount++;
+        } else if (arg == "--bench-lex") {
+            lexBench = true;
+            flagCount++;
+        } else if (arg == "--stream") {
+            streaming = true;
+            flagCount++;
+        } else if (arg == "--no-cache") {
+            AstCache::setEnabled(false);
+            flagCount++;
+        } else if ((arg == "--snapshot" || arg == "--image") && i + 1 < argc) {
+            (arg == "--snapshot" ? snapshotPath : imagePath) = argv[++i];
+            flagCount += 2;
         }
     }
 
-    if (argc < 2 || (argc == 2 && debugMode)) {
+    Runtime runtime(engine, useJit); 
+    if (!imagePath.empty() && !runtime.loadImage(imagePath)) return 1;
+
+    if (argc - 1 == flagCount) {
         std::cout << "NebulaOS Link-Lang v0.2 (Interactive)" << std::endl;
         if (debugMode) std::cout << "[DEBUG MODE ACTIVE]" << std::endl;
         std::cout << "Type 'exit' or './link --help'" << std::endl;
@@ -106,7 +183,11 @@ int main(int argc, char** argv) {
     std::string filename;
     for(int i=1; i<argc; i++) {
         std::string arg = argv[i];
-        if (arg != "--debug") {
+        if (arg == "--snapshot" || arg == "--image") {
+            i++;
+            continue;
+        }
+        if (arg != "--debug" && arg != "--jit" && arg != "--bench-lex" && arg != "--stream" && arg != "--no-cache" && arg.rfind("--engine=", 0) != 0) {
             filename = arg;
             break;
         }
@@ -117,16 +198,26 @@ int main(int argc, char** argv) {
         return 1;
     }
 
-    std::ifstream file(filename);
-    if(!file){
+    // Source di-mmap: Lexer membaca langsung dari page cache, tanpa salinan di heap
+    Sys::MappedFile file(filename);
+    if (!file.isOpen()) {
         std::cout << "No such file or directory: " << filename << std::endl;
         return 1;
     }
+    std::string_view source = file.text();
+
+    if (lexBench) {
+        benchLexer(source);
+        return 0;
+    }
 
-    std::string source((std::istreambuf_iterator<char>(file)),
-                        std::istreambuf_iterator<char>());
+    if (!snapshotPath.empty()) {
+        if (!run(runtime, source, debugMode, filename)) return 1;
+        return runtime.saveImage(snapshotPath) ? 0 : 1;
+    }
 
-    run(runtime, source, debugMode);
+    if (streaming) runStreaming(runtime, source, debugMode);
+    else run(runtime, source, debugMode, filename);
 
     return 0;        
 }
@@ -0,0 +1,129 @@
+#include "memo.h"
+#include <functional>
+#include <list>
+#include <unordered_map>
+
+namespace {
+    struct Entry {
+        const FuncDecl* fn;
+        size_t hash;
+        int argc;
+        Obj args[Memo::MAX_ARGS];
+        Obj result;
+    };
+
+    // Depan = paling baru dipakai. Index per hash, bentrok hash dibedakan lewat equal().
+    std::list<Entry> entries;
+    std::unordered_multimap<size_t, std::list<Entry>::iterator> byHash;
+    size_t limit = Memo::DEFAULT_CAPACITY;
+
+    bool cacheable(const Obj& value) {
+        return !value.isHeap() || value.isString();
+    }
+
+    size_t hashValue(const Obj& value) {
+        size_t h = 0;
+        switch (value.type) {
+            case Type::Int: h = std::hash<int>()(value.asInt()); break;
+            case Type::Double: h = std::hash<double>()(value.asDouble()); break;
+            case Type::Char: h = std::hash<char>()(value.asChar()); break;
+            case Type::Bool: h = value.asBool() ? 1 : 2; break;
+            case Type::String: h = std::hash<std::string>()(value.asString()); break;
+            default: break;
+        }
+        return h * 31 + (size_t)value.type;
+    }
+
+    bool equal(const Obj& a, const Obj& b) {
+        if (a.type != b.type) return false;
+        switch (a.type) {
+            case Type::Int: return a.asInt() == b.asInt();
+            case Type::Double: return a.asDouble() == b.asDouble();
+            case Type::Char: return a.asChar() == b.asChar();
+            case Type::Bool: return a.asBool() == b.asBool();
+            case Type::String: return a.asString() == b.asString();
+            default: return true;
+        }
+    }
+
+    // false kalau ada argumen yang tidak bisa jadi key
+    bool keyHash(const FuncDecl* fn, const Obj* args, int argc, size_t& hash) {
+        if (argc > Memo::MAX_ARGS) return false;
+        hash = std::hash<const void*>()(fn);
+        for (int i = 0; i < argc; ++i) {
+            if (!cacheable(args[i])) return false;
+            hash ^= hashValue(args[i]) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        }
+        return true;
+    }
+
+    std::list<Entry>::iterator find(const FuncDecl* fn, const Obj* args, int argc, size_t hash) {
+        auto range = byHash.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            Entry& entry = *it->second;
+            if (entry.fn != fn || entry.argc != argc) continue;
+            bool same = true;
+            for (int i = 0; i < argc && same; ++i) same = equal(entry.args[i], args[i]);
+            if (same) return it->second;
+        }
+        return entries.end();
+    }
+
+    void evictOldest() {
+        auto oldest = std::prev(entries.end());
+        auto range = byHash.equal_range(oldest->hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == oldest) {
+                byHash.erase(it);
+                break;
+            }
+        }
+        entries.pop_back();
+    }
+}
+
+namespace Memo {
+    bool lookup(const FuncDecl* fn, const Obj* args, int argc, Obj& result) {
+        size_t hash;
+        if (entries.empty() || !keyHash(fn, args, argc, hash)) return false;
+        auto it = find(fn, args, argc, hash);
+        if (it == entries.end()) return false;
+        entries.splice(entries.begin(), entries, it);
+        result = it->result;
+        return true;
+    }
+
+    void store(const FuncDecl* fn, const Obj* args, int argc, const Obj& result) {
+        size_t hash;
+        if (limit == 0 || !cacheable(result) || !keyHash(fn, args, argc, hash)) return;
+        auto it = find(fn, args, argc, hash);
+        if (it != entries.end()) {
+            // Rekursi bisa menghitung key yang sama lebih dulu
+            it->result = result;
+            entries.splice(entries.begin(), entries, it);
+            return;
+        }
+        entries.emplace_front();
+        Entry& entry = entries.front();
+        entry.fn = fn;
+        entry.hash = hash;
+        entry.argc = argc;
+        for (int i = 0; i < argc; ++i) entry.args[i] = args[i];
+        entry.result = result;
+        byHash.emplace(hash, entries.begin());
+        while (entries.size() > limit) evictOldest();
+    }
+
+    void clear() {
+        byHash.clear();
+        entries.clear();
+    }
+
+    size_t size() { return entries.size(); }
+    size_t capacity() { return limit; }
+
+    void setCapacity(size_t entriesMax) {
+        limit = entriesMax;
+        while (entries.size() > limit) evictOldest();
+    }
+}
@@ -0,0 +1,92 @@
+#include "module.h"
+#include "lexer.h"
+
+Module* ModuleRegistry::find(const std::string& path) {
+    auto it = modules.find(path);
+    return it != modules.end() ? it->second.get() : nullptr;
+}
+
+Module& ModuleRegistry::begin(const std::string& path, const std::string& name, Program* program) {
+    Module& module = defer(path, name);
+    module.program = program;
+    start(module);
+    return module;
+}
+
+Module& ModuleRegistry::defer(const std::string& path, const std::string& name) {
+    auto& slot = modules[path];
+    slot = std::make_unique<Module>();
+    slot->path = path;
+    slot->name = name;
+    return *slot;
+}
+
+void ModuleRegistry::start(Module& module) {
+    module.state = Module::State::Loading;
+    loading.push_back(&module);
+}
+
+void ModuleRegistry::finish(Module& module, bool ok) {
+    if (!loading.empty() && loading.back() == &module) loading.pop_back();
+    if (ok) module.state = Module::State::Loaded;
+    else modules.erase(module.path);
+}
+
+std::vector<const Module*> ModuleRegistry::list() const {
+    std::vector<const Module*> all;
+    for (auto& entry : modules) all.push_back(entry.second.get());
+    return all;
+}
+
+std::string ModuleRegistry::cycle(const Module& module) const {
+    std::string chain;
+    bool inCycle = false;
+    for (Module* m : loading) {
+        if (m == &module) inCycle = true;
+        if (inCycle) chain += m->name + " -> ";
+    }
+    return chain + module.name;
+}
+
+namespace {
+    // Blok yang tetap berjalan di scope global (bukan body fungsi / method)
+    void collect(Module& module, const std::vector<std::unique_ptr<Stmt>>& body) {
+        for (auto& stmt : body) {
+            Stmt* s = stmt.get();
+            if (auto set = dynamic_cast<SetStmt*>(s)) {
+                if (set->ref.local < 0) module.globals.push_back(set->ref.global);
+            }
+            else if (auto cls = dynamic_cast<ClassDecl*>(s)) {
+                if (cls->ref.local < 0) module.globals.push_back(cls->ref.global);
+            }
+            else if (auto func = dynamic_cast<FuncDecl*>(s)) module.functions.push_back(func->slot);
+            else if (auto ifStmt = dynamic_cast<IfStmt*>(s)) {
+                collect(module, ifStmt->thenBranch);
+                collect(module, ifStmt->elseBranch);
+            }
+            else if (auto whileLoop = dynamic_cast<WhileStmt*>(s)) collect(module, whileLoop->body);
+            else if (auto loop = dynamic_cast<ForStmt*>(s)) collect(module, loop->body);
+            else if (auto tryStmt = dynamic_cast<TryStmt*>(s)) {
+                collect(module, tryStmt->tryBody);
+                collect(module, tryStmt->catchBody);
+            }
+        }
+    }
+}
+
+void exportsOf(Module& module) {
+    module.globals.clear();
+    module.functions.clear();
+    if (module.program) collect(module, module.program->statements);
+}
+
+void declaredNames(std::string_view source, std::vector<std::string>& globals, std::vector<std::string>& functions) {
+    Lexer lexer(source);
+    std::vector<Token> tokens = lexer.tokenize();
+    for (size_t i = 0; i + 1 < tokens.size(); i++) {
+        if (tokens[i + 1].type != TokenType::IDENTIFIER) continue;
+        std::string name(tokens[i + 1].text(source));
+        if (tokens[i].type == TokenType::FUNC) functions.push_back(name);
+        else if (tokens[i].type == TokenType::SET || tokens[i].type == TokenType::CLASS) globals.push_back(name);
+    }
+}
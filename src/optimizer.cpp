@@ -0,0 +1,320 @@
+#include "optimizer.h"
+#include <atomic>
+#include "builtins.h"
+#include "ops.h"
+
+namespace {
+
+// Builtin tanpa efek samping dan tanpa pesan error; hasilnya hanya bergantung pada argumen
+bool isPureBuiltin(const std::string& name) {
+    static const std::unordered_set<std::string> pure = {
+        "len", "str.len", "str.trim", "str.replace", "str.contains",
+        "math.pi", "math.sin", "math.cos", "math.tan", "math.sqrt", "math.abs", "math.pow",
+    };
+    return pure.count(name) > 0;
+}
+
+bool isLiteral(Expr* expr, Obj& value) {
+    if (auto num = dynamic_cast<NumberExpr*>(expr)) value = Obj(num->value);
+    else if (auto flt = dynamic_cast<FloatExpr*>(expr)) value = Obj(flt->value);
+    else if (auto str = dynamic_cast<StringExpr*>(expr)) value = Obj(str->value);
+    else if (auto chr = dynamic_cast<CharExpr*>(expr)) value = Obj(chr->value);
+    else if (auto bl = dynamic_cast<BoolExpr*>(expr)) value = Obj(bl->value);
+    else return false;
+    return true;
+}
+
+// Nil tidak punya literal, jadi hasil nil tidak di-fold
+std::unique_ptr<Expr> toLiteral(const Obj& value) {
+    if (value.isInt()) return std::make_unique<NumberExpr>(value.asInt());
+    if (value.isDouble()) return std::make_unique<FloatExpr>(value.asDouble());
+    if (value.isBool()) return std::make_unique<BoolExpr>(value.asBool());
+    if (value.isString()) return std::make_unique<StringExpr>(value.asString());
+    return nullptr;
+}
+
+std::atomic<int> hoistCounter{0}; // global supaya nama sementara unik di semua Program (REPL, import)
+
+} // namespace
+
+void Optimizer::optimize(Program& program) {
+    Arena::Scope scope(program.arena); // node hasil folding/hoisting ikut arena program
+    optimizeBlock(program.statements);
+}
+
+void Optimizer::optimizeBlock(std::vector<std::unique_ptr<Stmt>>& body) {
+    std::vector<std::unique_ptr<Stmt>> out;
+    out.reserve(body.size());
+    for (auto& stmtPtr : body) {
+        optimizeStmt(stmtPtr.get());
+
+        if (auto ifStmt = dynamic_cast<IfStmt*>(stmtPtr.get())) {
+            Obj cond;
+            if (isLiteral(ifStmt->condition.get(), cond)) {
+                // Cabang if tidak punya scope sendiri, jadi isinya aman dipindah ke block ini
+                auto& live = isTruthy(cond) ? ifStmt->thenBranch : ifStmt->elseBranch;
+                for (auto& s : live) out.push_back(std::move(s));
+                continue;
+            }
+        }
+        if (dynamic_cast<WhileStmt*>(stmtPtr.get()) || dynamic_cast<ForStmt*>(stmtPtr.get())) {
+            hoistLoop(stmtPtr.get(), out);
+        }
+        out.push_back(std::move(stmtPtr));
+    }
+    body = std::move(out);
+}
+
+void Optimizer::optimizeStmt(Stmt* stmt) {
+    if (auto set = dynamic_cast<SetStmt*>(stmt)) fold(set->expression);
+    else if (auto exprStmt = dynamic_cast<ExprStmt*>(stmt)) fold(exprStmt->expression);
+    else if (auto call = dynamic_cast<CallStmt*>(stmt)) {
+        for (auto& arg : call->args) fold(arg);
+    }
+    else if (auto ret = dynamic_cast<ReturnStmt*>(stmt)) fold(ret->value);
+    else if (auto ifStmt = dynamic_cast<IfStmt*>(stmt)) {
+        fold(ifStmt->condition);
+        optimizeBlock(ifStmt->thenBranch);
+        optimizeBlock(ifStmt->elseBranch);
+    }
+    else if (auto whileLoop = dynamic_cast<WhileStmt*>(stmt)) {
+        fold(whileLoop->condition);
+        optimizeBlock(whileLoop->body);
+    }
+    else if (auto loop = dynamic_cast<ForStmt*>(stmt)) {
+        fold(loop->collection);
+        optimizeBlock(loop->body);
+    }
+    else if (auto tryStmt = dynamic_cast<TryStmt*>(stmt)) {
+        optimizeBlock(tryStmt->tryBody);
+        optimizeBlock(tryStmt->catchBody);
+    }
+    else if (auto func = dynamic_cast<FuncDecl*>(stmt)) optimizeBlock(func->body);
+    else if (auto cls = dynamic_cast<ClassDecl*>(stmt)) {
+        for (auto& method : cls->methods) optimizeBlock(method->body);
+    }
+    else if (auto app = dynamic_cast<AppDecl*>(stmt)) optimizeBlock(app->body);
+    else if (auto window = dynamic_cast<WindowDecl*>(stmt)) optimizeBlock(window->body);
+}
+
+void Optimizer::fold(std::unique_ptr<Expr>& expr) {
+    if (!expr) return;
+
+    if (auto bin = dynamic_cast<BinaryExpr*>(expr.get())) {
+        fold(bin->lhs);
+        fold(bin->rhs);
+        Obj left, right;
+        if (isLiteral(bin->lhs.get(), left) && isLiteral(bin->rhs.get(), right)) {
+            if (auto folded = toLiteral(binaryOp(bin->op, left, right))) expr = std::move(folded);
+        }
+    }
+    else if (auto call = dynamic_cast<CallExpr*>(expr.get())) {
+        for (auto& arg : call->args) fold(arg);
+    }
+    else if (auto methodCall = dynamic_cast<MethodCallExpr*>(expr.get())) {
+        fold(methodCall->object);
+        for (auto& arg : methodCall->args) fold(arg);
+    }
+    else if (auto newExpr = dynamic_cast<NewExpr*>(expr.get())) {
+        for (auto& arg : newExpr->args) fold(arg);
+    }
+    else if (auto get = dynamic_cast<GetExpr*>(expr.get())) fold(get->object);
+    else if (auto set = dynamic_cast<SetExpr*>(expr.get())) {
+        fold(set->object);
+        fold(set->value);
+    }
+    else if (auto arr = dynamic_cast<ArrayExpr*>(expr.get())) {
+        for (auto& el : arr->elements) fold(el);
+    }
+    else if (auto dict = dynamic_cast<DictExpr*>(expr.get())) {
+        for (auto& p : dict->pairs) {
+            fold(p.first);
+            fold(p.second);
+        }
+    }
+    else if (auto idx = dynamic_cast<IndexExpr*>(expr.get())) {
+        fold(idx->object);
+        fold(idx->index);
+    }
+}
+
+// --- Loop-invariant hoisting ---
+
+void Optimizer::scanBlock(const std::vector<std::unique_ptr<Stmt>>& body, LoopEffects& effects) {
+    for (auto& stmtPtr : body) {
+        Stmt* stmt = stmtPtr.get();
+        if (auto set = dynamic_cast<SetStmt*>(stmt)) {
+            effects.written.insert(set->name);
+            scanExpr(set->expression.get(), effects);
+        }
+        else if (auto up = dynamic_cast<UpdateStmt*>(stmt)) effects.written.insert(up->name);
+        else if (auto exprStmt = dynamic_cast<ExprStmt*>(stmt)) scanExpr(exprStmt->expression.get(), effects);
+        else if (auto call = dynamic_cast<CallStmt*>(stmt)) {
+            if (Builtins::find(call->func) < 0) effects.opaque = true;
+            else if (call->func == "list.add") effects.mutates = true;
+            for (auto& arg : call->args) scanExpr(arg.get(), effects);
+        }
+        else if (auto ret = dynamic_cast<ReturnStmt*>(stmt)) scanExpr(ret->value.get(), effects);
+        else if (auto ifStmt = dynamic_cast<IfStmt*>(stmt)) {
+            scanExpr(ifStmt->condition.get(), effects);
+            scanBlock(ifStmt->thenBranch, effects);
+            scanBlock(ifStmt->elseBranch, effects);
+        }
+        else if (auto whileLoop = dynamic_cast<WhileStmt*>(stmt)) {
+            scanExpr(whileLoop->condition.get(), effects);
+            scanBlock(whileLoop->body, effects);
+        }
+        else if (auto loop = dynamic_cast<ForStmt*>(stmt)) {
+            effects.written.insert(loop->iteratorName);
+            scanExpr(loop->collection.get(), effects);
+            scanBlock(loop->body, effects);
+        }
+        else if (auto tryStmt = dynamic_cast<TryStmt*>(stmt)) {
+            effects.written.insert(tryStmt->errorVar);
+            scanBlock(tryStmt->tryBody, effects);
+            scanBlock(tryStmt->catchBody, effects);
+        }
+        else if (auto cls = dynamic_cast<ClassDecl*>(stmt)) effects.written.insert(cls->name);
+        else if (dynamic_cast<ImportStmt*>(stmt)) effects.opaque = true; // modul jalan di scope global
+        else if (auto app = dynamic_cast<AppDecl*>(stmt)) scanBlock(app->body, effects);
+        else if (auto window = dynamic_cast<WindowDecl*>(stmt)) scanBlock(window->body, effects);
+    }
+}
+
+void Optimizer::scanExpr(Expr* expr, LoopEffects& effects) {
+    if (!expr) return;
+
+    if (auto bin = dynamic_cast<BinaryExpr*>(expr)) {
+        scanExpr(bin->lhs.get(), effects);
+        scanExpr(bin->rhs.get(), effects);
+    }
+    else if (auto call = dynamic_cast<CallExpr*>(expr)) {
+        if (Builtins::find(call->func) < 0) effects.opaque = true;
+        else if (call->func == "list.add") effects.mutates = true;
+        for (auto& arg : call->args) scanExpr(arg.get(), effects);
+    }
+    // Fungsi user / method / init bisa menjalankan import yang mengubah global
+    else if (dynamic_cast<MethodCallExpr*>(expr) || dynamic_cast<NewExpr*>(expr)) effects.opaque = true;
+    else if (auto get = dynamic_cast<GetExpr*>(expr)) scanExpr(get->object.get(), effects);
+    else if (auto set = dynamic_cast<SetExpr*>(expr)) {
+        scanExpr(set->object.get(), effects);
+        scanExpr(set->value.get(), effects);
+    }
+    else if (auto arr = dynamic_cast<ArrayExpr*>(expr)) {
+        for (auto& el : arr->elements) scanExpr(el.get(), effects);
+    }
+    else if (auto dict = dynamic_cast<DictExpr*>(expr)) {
+        for (auto& p : dict->pairs) {
+            scanExpr(p.first.get(), effects);
+            scanExpr(p.second.get(), effects);
+        }
+    }
+    else if (auto idx = dynamic_cast<IndexExpr*>(expr)) {
+        scanExpr(idx->object.get(), effects);
+        scanExpr(idx->index.get(), effects);
+    }
+}
+
+// Invariant = murni, tidak bisa gagal, dan semua variabelnya tidak di-set di dalam loop
+bool Optimizer::isInvariant(Expr* expr, const LoopEffects& effects) {
+    Obj value;
+    if (isLiteral(expr, value)) return true;
+    if (auto var = dynamic_cast<VariableExpr*>(expr)) return effects.written.count(var->name) == 0;
+    if (auto bin = dynamic_cast<BinaryExpr*>(expr)) {
+        return isInvariant(bin->lhs.get(), effects) && isInvariant(bin->rhs.get(), effects);
+    }
+    if (auto call = dynamic_cast<CallExpr*>(expr)) {
+        if (effects.mutates || !isPureBuiltin(call->func)) return false;
+        for (auto& arg : call->args) {
+            if (!isInvariant(arg.get(), effects)) return false;
+        }
+        return true;
+    }
+    return false;
+}
+
+void Optimizer::hoistLoop(Stmt* loop, std::vector<std::unique_ptr<Stmt>>& out) {
+    LoopEffects effects;
+    if (auto whileLoop = dynamic_cast<WhileStmt*>(loop)) {
+        scanExpr(whileLoop->condition.get(), effects);
+        scanBlock(whileLoop->body, effects);
+        if (effects.opaque) return;
+        hoistExpr(whileLoop->condition, effects, out);
+        hoistBlock(whileLoop->body, effects, out);
+    }
+    else if (auto forLoop = dynamic_cast<ForStmt*>(loop)) {
+        effects.written.insert(forLoop->iteratorName);
+        scanBlock(forLoop->body, effects);
+        if (effects.opaque) return;
+        hoistBlock(forLoop->body, effects, out);
+    }
+}
+
+// Tidak masuk ke try/catch (scope catch bisa mengubah arti nama) maupun func/class
+void Optimizer::hoistBlock(std::vector<std::unique_ptr<Stmt>>& body, const LoopEffects& effects, std::vector<std::unique_ptr<Stmt>>& out) {
+    for (auto& stmtPtr : body) {
+        Stmt* stmt = stmtPtr.get();
+        if (auto set = dynamic_cast<SetStmt*>(stmt)) hoistExpr(set->expression, effects, out);
+        else if (auto exprStmt = dynamic_cast<ExprStmt*>(stmt)) hoistExpr(exprStmt->expression, effects, out);
+        else if (auto call = dynamic_cast<CallStmt*>(stmt)) {
+            for (auto& arg : call->args) hoistExpr(arg, effects, out);
+        }
+        else if (auto ret = dynamic_cast<ReturnStmt*>(stmt)) hoistExpr(ret->value, effects, out);
+        else if (auto ifStmt = dynamic_cast<IfStmt*>(stmt)) {
+            hoistExpr(ifStmt->condition, effects, out);
+            hoistBlock(ifStmt->thenBranch, effects, out);
+            hoistBlock(ifStmt->elseBranch, effects, out);
+        }
+        else if (auto whileLoop = dynamic_cast<WhileStmt*>(stmt)) {
+            hoistExpr(whileLoop->condition, effects, out);
+            hoistBlock(whileLoop->body, effects, out);
+        }
+        else if (auto loop = dynamic_cast<ForStmt*>(stmt)) {
+            hoistExpr(loop->collection, effects, out);
+            hoistBlock(loop->body, effects, out);
+        }
+    }
+}
+
+std::string Optimizer::temporaryName() {
+    return "$inv" + std::to_string(hoistCounter++);
+}
+
+void Optimizer::hoistExpr(std::unique_ptr<Expr>& expr, const LoopEffects& effects, std::vector<std::unique_ptr<Stmt>>& out) {
+    if (!expr) return;
+
+    // Literal & variabel sudah murah; yang diangkat hanya operasi / panggilan builtin
+    bool worthIt = dynamic_cast<BinaryExpr*>(expr.get()) || dynamic_cast<CallExpr*>(expr.get());
+    if (worthIt && isInvariant(expr.get(), effects)) {
+        std::string name = temporaryName();
+        out.push_back(std::make_unique<SetStmt>(name, std::move(expr)));
+        expr = std::make_unique<VariableExpr>(name);
+        return;
+    }
+
+    if (auto bin = dynamic_cast<BinaryExpr*>(expr.get())) {
+        hoistExpr(bin->lhs, effects, out);
+        hoistExpr(bin->rhs, effects, out);
+    }
+    else if (auto call = dynamic_cast<CallExpr*>(expr.get())) {
+        for (auto& arg : call->args) hoistExpr(arg, effects, out);
+    }
+    else if (auto get = dynamic_cast<GetExpr*>(expr.get())) hoistExpr(get->object, effects, out);
+    else if (auto set = dynamic_cast<SetExpr*>(expr.get())) {
+        hoistExpr(set->object, effects, out);
+        hoistExpr(set->value, effects, out);
+    }
+    else if (auto arr = dynamic_cast<ArrayExpr*>(expr.get())) {
+        for (auto& el : arr->elements) hoistExpr(el, effects, out);
+    }
+    else if (auto dict = dynamic_cast<DictExpr*>(expr.get())) {
+        for (auto& p : dict->pairs) {
+            hoistExpr(p.first, effects, out);
+            hoistExpr(p.second, effects, out);
+        }
+    }
+    else if (auto idx = dynamic_cast<IndexExpr*>(expr.get())) {
+        hoistExpr(idx->object, effects, out);
+        hoistExpr(idx->index, effects, out);
+    }
+}
@@ -1,20 +1,60 @@
 #include "os.h"
 #include <fstream>
-#include <sstream>
+#include <iterator>
 #include <cstdio>
 #include <iostream>
 #include <cstdlib>
 #include <memory>
 #include <array>
+#include <cerrno>
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace Sys {
 
+    MappedFile::MappedFile(const std::string& path) {
+#ifndef _WIN32
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat info;
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+            void* p = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                madvise(p, (size_t)info.st_size, MADV_SEQUENTIAL);
+                data = static_cast<const char*>(p);
+                length = (size_t)info.st_size;
+                mapped = true;
+            }
+        }
+        close(fd);
+        if (mapped) { opened = true; return; }
+#endif
+        // File kosong, pipe/device, atau platform tanpa mmap
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return;
+        buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        data = buffer.data();
+        length = buffer.size();
+        opened = true;
+    }
+
+    MappedFile::~MappedFile() {
+#ifndef _WIN32
+        if (mapped) munmap(const_cast<char*>(data), length);
+#endif
+    }
+
     std::string readFile(const std::string& path) {
-        std::ifstream file(path);
-        if (!file.is_open()) return "";
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        return buffer.str();
+        MappedFile file(path);
+        return std::string(file.text()); // satu salinan, langsung seukuran file
     }
 
     void writeFile(const std::string& path, const std::string& content, bool append) {
@@ -29,6 +69,54 @@ namespace Sys {
         return file.good();
     }
 
+    long long fileTime(const std::string& path) {
+#ifdef _WIN32
+        struct _stat info;
+        if (_stat(path.c_str(), &info) != 0) return -1;
+        return (long long)info.st_mtime * 1000000000LL;
+#else
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0) return -1;
+        return (long long)info.st_mtim.tv_sec * 1000000000LL + info.st_mtim.tv_nsec;
+#endif
+    }
+
+    std::string canonicalPath(const std::string& path) {
+#ifdef _WIN32
+        char full[_MAX_PATH];
+        if (_fullpath(full, path.c_str(), _MAX_PATH)) return full;
+        return path;
+#else
+        char* full = realpath(path.c_str(), nullptr);
+        if (!full) return path;
+        std::string result(full);
+        free(full);
+        return result;
+#endif
+    }
+
+    bool makeDir(const std::string& path) {
+#ifdef _WIN32
+        return _mkdir(path.c_str()) == 0 || errno == EEXIST;
+#else
+        return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+#endif
+    }
+
+    int processId() {
+#ifdef _WIN32
+        return _getpid();
+#else
+        return (int)getpid();
+#endif
+    }
+
+    long long fileSize(const std::string& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) return -1;
+        return (long long)file.tellg();
+    }
+
     void removeFile(const std::string& path) {
         std::remove(path.c_str());
     }
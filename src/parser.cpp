@@ -1,17 +1,23 @@
 #include "parser.h"
+#include <algorithm>
 #include <stdexcept>
 #include <iostream>
 
-Parser::Parser(const std::vector<Token>& t) : tokens(t), current(0) {}
+Parser::Parser(std::vector<Token> t, std::string_view source) : tokens(std::move(t)), src(source), current(0) {}
 
-const Token& Parser::peek() const { return tokens[current]; }
+Parser::Parser(Lexer& lexer, std::string_view source) : lexer(&lexer), src(source), current(0) {}
+
+const Token& Parser::peek() { if (current >= tokens.size()) fill(current + 1); return tokens[current]; }
+const Token& Parser::lookahead(size_t n) { fill(current + n + 1); return tokens[std::min(current + n, tokens.size() - 1)]; }
+void Parser::fill(size_t count) { if (lexer && tokens.size() < count) lexer->scan(tokens, count); }
 const Token& Parser::advance() { if (!isAtEnd()) current++; return tokens[current - 1]; }
 bool Parser::match(TokenType type) { if (isAtEnd()) return false; if (peek().type == type) { advance(); return true; } return false; }
 const Token& Parser::consume(TokenType type, const std::string& err) { if (match(type)) return tokens[current - 1]; throw std::runtime_error(err); }
-bool Parser::isAtEnd() const { return peek().type == TokenType::EOF_TOKEN; }
+bool Parser::isAtEnd() { return peek().type == TokenType::EOF_TOKEN; }
 
 std::unique_ptr<Program> Parser::parse() {
     auto program = std::make_unique<Program>();
+    Arena::Scope scope(program->arena);
     while (!isAtEnd()) {
         auto stmt = parseStatement();
         if (stmt) program->statements.push_back(std::move(stmt));
@@ -19,6 +25,22 @@ std::unique_ptr<Program> Parser::parse() {
     return program;
 }
 
+// Mode streaming: satu statement top-level per Program (arena sendiri), nullptr kalau source habis.
+// Token yang sudah dipakai dibuang, jadi memori parser tidak tumbuh dengan ukuran script.
+std::unique_ptr<Program> Parser::parseNext() {
+    while (!isAtEnd()) {
+        tokens.erase(tokens.begin(), tokens.begin() + current);
+        current = 0;
+        auto program = std::make_unique<Program>();
+        Arena::Scope scope(program->arena);
+        auto stmt = parseStatement();
+        if (!stmt) continue;
+        program->statements.push_back(std::move(stmt));
+        return program;
+    }
+    return nullptr;
+}
+
 std::vector<std::unique_ptr<Expr>> Parser::parseArguments() {
     std::vector<std::unique_ptr<Expr>> args;
     if (match(TokenType::LPAREN)) {
@@ -36,7 +58,7 @@ std::unique_ptr<Stmt> Parser::parseStatement() {
     if (match(TokenType::CLEAR) || match(TokenType::CLS)) return std::make_unique<ClearStmt>();
     if (match(TokenType::CLASS)) return parseClass(); 
     if (match(TokenType::IMPORT)){
-		std::string path = consume(TokenType::STRING, "Expectes File Path After 'import'").value; 
+		std::string path(lexeme(consume(TokenType::STRING, "Expectes File Path After 'import'"))); 
 		return std::make_unique<ImportStmt>(path); 
 	}
     if (match(TokenType::SET)) 		return parseSet(); 
@@ -51,20 +73,37 @@ std::unique_ptr<Stmt> Parser::parseStatement() {
     if (match(TokenType::TRY)) 		return parseTry(); 
         
     if (match(TokenType::SH)){
-        auto command = consume(TokenType::STRING, "Error: 'sh' needs string").value; 
+        std::string command(lexeme(consume(TokenType::STRING, "Error: 'sh' needs string"))); 
         return std::make_unique<PropertyStmt>("sh", command); 
     }
 
+    // 'lazy import "file"': sama seperti memo, lazy bukan keyword
+    if (peek().type == TokenType::IDENTIFIER && lexeme(peek()) == "lazy" && lookahead(1).type == TokenType::IMPORT) {
+        current += 2;
+        std::string path(lexeme(consume(TokenType::STRING, "Expectes File Path After 'import'")));
+        auto imp = std::make_unique<ImportStmt>(path);
+        imp->lazy = true;
+        return imp;
+    }
+
+    // 'memo func f(...)': memo bukan keyword, jadi tetap boleh dipakai sebagai nama variabel
+    if (peek().type == TokenType::IDENTIFIER && lexeme(peek()) == "memo" && lookahead(1).type == TokenType::FUNC) {
+        current += 2;
+        auto func = parseFunc();
+        func->memo = true;
+        return func;
+    }
+
     if (peek().type == TokenType::IDENTIFIER) {
-        std::string name = advance().value; 
+        std::string name(lexeme(advance())); 
         std::string method = "";
         bool isMethodCall = false;
 
         if (match(TokenType::DOT)) {
-            method = consume(TokenType::IDENTIFIER, "Expected method").value; 
+            method = lexeme(consume(TokenType::IDENTIFIER, "Expected method")); 
             
             if (name == "time" || name == "math" || name == "io" || 
-                name == "os"   || name == "str"  || name == "list") {
+                name == "os"   || name == "str"  || name == "list" || name == "sys") {
                 
                 name += "." + method; 
                 isMethodCall = false; 
@@ -118,9 +157,9 @@ std::unique_ptr<Stmt> Parser::parseStatement() {
 std::unique_ptr<Expr> Parser::parseExpression() {
     auto left = parseAdditive();
     while (match(TokenType::LT) || match(TokenType::GT) || match(TokenType::EQ_EQ)) {
-        std::string op = tokens[current - 1].value;
+        char op = lexeme(tokens[current - 1])[0];
         auto right = parseAdditive();
-        left = std::make_unique<BinaryExpr>(op[0], std::move(left), std::move(right));
+        left = std::make_unique<BinaryExpr>(op, std::move(left), std::move(right));
     }
     return left;
 }
@@ -129,7 +168,7 @@ std::unique_ptr<Expr> Parser::parseAdditive() {
     
     auto left = parseTerm(); 
     while (match(TokenType::PLUS) || match(TokenType::MINUS)) {
-        char op = tokens[current - 1].value[0];
+        char op = lexeme(tokens[current - 1])[0];
         auto right = parseTerm(); 
         left = std::make_unique<BinaryExpr>(op, std::move(left), std::move(right));
     }
@@ -139,7 +178,7 @@ std::unique_ptr<Expr> Parser::parseAdditive() {
 std::unique_ptr<Expr> Parser::parseTerm() {
     auto left = parseUnary(); 
     while (match(TokenType::STAR) || match(TokenType::SLASH)) {
-        char op = tokens[current - 1].value[0];
+        char op = lexeme(tokens[current - 1])[0];
         auto right = parseUnary(); 
         left = std::make_unique<BinaryExpr>(op, std::move(left), std::move(right));
     }
@@ -163,7 +202,7 @@ std::unique_ptr<Expr> Parser::parsePostfix() {
             expr = std::make_unique<IndexExpr>(std::move(expr), std::move(index));
         } 
         else if (match(TokenType::DOT)) {
-            std::string name = consume(TokenType::IDENTIFIER, "Expected property name").value;
+            Name name = lexeme(consume(TokenType::IDENTIFIER, "Expected property name"));
             expr = std::make_unique<GetExpr>(std::move(expr), name);
         }
         else if (match(TokenType::LPAREN)) {
@@ -200,7 +239,7 @@ std::unique_ptr<Expr> Parser::parsePrimary() {
     if (match(TokenType::THIS)) return std::make_unique<ThisExpr>(tokens[current - 1]);
 
     if (match(TokenType::NEW)) {
-        std::string className = consume(TokenType::IDENTIFIER, "Expected class name").value;
+        std::string className(lexeme(consume(TokenType::IDENTIFIER, "Expected class name")));
         consume(TokenType::LPAREN, "Expected '(' after class name");
         std::vector<std::unique_ptr<Expr>> args;
         if (peek().type != TokenType::RPAREN) {
@@ -212,10 +251,10 @@ std::unique_ptr<Expr> Parser::parsePrimary() {
         return std::make_unique<NewExpr>(className, std::move(args));
     }
 	
-    if (match(TokenType::TOKEN_NUM)) return std::make_unique<NumberExpr>(std::stoi(tokens[current - 1].value));
-    if (match(TokenType::TOKEN_FLOAT)) return std::make_unique<FloatExpr>(std::stod(tokens[current - 1].value));
-    if (match(TokenType::STRING)) return std::make_unique<StringExpr>(tokens[current - 1].value);
-    if (match(TokenType::CHAR)) return std::make_unique<CharExpr>(tokens[current - 1].value[0]);
+    if (match(TokenType::TOKEN_NUM)) return std::make_unique<NumberExpr>(tokens[current - 1].intValue);
+    if (match(TokenType::TOKEN_FLOAT)) return std::make_unique<FloatExpr>(tokens[current - 1].floatValue);
+    if (match(TokenType::STRING)) return std::make_unique<StringExpr>(std::string(lexeme(tokens[current - 1])));
+    if (match(TokenType::CHAR)) return std::make_unique<CharExpr>(lexeme(tokens[current - 1])[0]);
     if (match(TokenType::TRUE)) return std::make_unique<BoolExpr>(true);
     if (match(TokenType::FALSE)) return std::make_unique<BoolExpr>(false);
 
@@ -254,17 +293,17 @@ std::unique_ptr<Expr> Parser::parsePrimary() {
     }
 
     if (peek().type == TokenType::IDENTIFIER) {
-         if (peek().value == "input") {
+         if (lexeme(peek()) == "input") {
             advance(); consume(TokenType::LPAREN, "Expected '('");
             std::string prompt = "";
-            if (peek().type == TokenType::STRING) prompt = advance().value;
+            if (peek().type == TokenType::STRING) prompt = lexeme(advance());
             consume(TokenType::RPAREN, "Expected ')'");
             return std::make_unique<InputExpr>(prompt);
         }
-        std::string name = advance().value;
+        Name name = lexeme(advance());
         if (match(TokenType::DOT)) {
-            std::string method = consume(TokenType::IDENTIFIER, "Expected method").value;
-            name += "." + method; 
+            std::string method(lexeme(consume(TokenType::IDENTIFIER, "Expected method")));
+            name = name + "." + method; 
         }
         if (peek().type == TokenType::LPAREN) {
             auto args = parseArguments();
@@ -277,7 +316,7 @@ std::unique_ptr<Expr> Parser::parsePrimary() {
         consume(TokenType::RPAREN, "Butuh ')'");
         return expr;
     }
-    throw std::runtime_error("Unknown token: " + peek().value);
+    throw std::runtime_error("Unknown token: " + std::string(lexeme(peek())));
 }
 
 std::unique_ptr<Stmt> Parser::parseSet() {
@@ -328,7 +367,7 @@ std::unique_ptr<Stmt> Parser::parseWhile() {
 
 std::unique_ptr<AppDecl> Parser::parseApp() {
     std::string name;
-    if (peek().type == TokenType::IDENTIFIER || peek().type == TokenType::STRING) name = advance().value;
+    if (peek().type == TokenType::IDENTIFIER || peek().type == TokenType::STRING) name = lexeme(advance());
     else throw std::runtime_error("Error: App-name must be word");
     consume(TokenType::NEWLINE, "Newline needed");
     consume(TokenType::INDENT, "Indent needed");
@@ -391,7 +430,7 @@ std::unique_ptr<Stmt> Parser::parseIf() {
 }
 
 std::unique_ptr<Stmt> Parser::parseFor() {
-    auto iteratorName = consume(TokenType::IDENTIFIER, "Expected iterator variable").value;
+    auto iteratorName = lexeme(consume(TokenType::IDENTIFIER, "Expected iterator variable"));
     consume(TokenType::IN, "Expected 'in' after iterator");
     auto collection = parseExpression();
     
@@ -419,7 +458,7 @@ std::unique_ptr<Stmt> Parser::parseFor() {
 }
 
 std::unique_ptr<WindowDecl> Parser::parseWindow() {
-    auto name = consume(TokenType::IDENTIFIER, "Expected window name").value;
+    std::string name(lexeme(consume(TokenType::IDENTIFIER, "Expected window name")));
     consume(TokenType::NEWLINE, "Expected newline");
     consume(TokenType::INDENT, "Expected indent");
     auto window = std::make_unique<WindowDecl>(name);
@@ -435,14 +474,14 @@ std::unique_ptr<FuncDecl> Parser::parseFunc() {
     if (match(TokenType::INIT)) {
         name = "init";
     } else {
-        name = consume(TokenType::IDENTIFIER, "Expected func name").value;
+        name = lexeme(consume(TokenType::IDENTIFIER, "Expected func name"));
     }
 
-    std::vector<std::string> params;
+    std::vector<Name> params;
     if (match(TokenType::LPAREN)) {
         if (peek().type != TokenType::RPAREN) {
             do { 
-                params.push_back(consume(TokenType::IDENTIFIER, "Expected param").value);
+                params.push_back(lexeme(consume(TokenType::IDENTIFIER, "Expected param")));
             } while (match(TokenType::COMMA));
         }
         consume(TokenType::RPAREN, "Expected ')'");
@@ -477,7 +516,7 @@ std::unique_ptr<FuncDecl> Parser::parseFunc() {
 }
 
 std::unique_ptr<Stmt> Parser::parseClass() {
-    std::string name = consume(TokenType::IDENTIFIER, "Expected class name").value;
+    std::string name(lexeme(consume(TokenType::IDENTIFIER, "Expected class name")));
     consume(TokenType::LBRACE, "Expected '{'");
 
     std::vector<std::unique_ptr<FuncDecl>> methods;
@@ -494,11 +533,11 @@ std::unique_ptr<Stmt> Parser::parseClass() {
 }
 
 std::unique_ptr<ConnectStmt> Parser::parseConnect() {
-    auto source = consume(TokenType::IDENTIFIER, "Expected source").value;
+    std::string source(lexeme(consume(TokenType::IDENTIFIER, "Expected source")));
     consume(TokenType::DOT, "Expected dot");
-    auto event = consume(TokenType::IDENTIFIER, "Expected event").value;
+    std::string event(lexeme(consume(TokenType::IDENTIFIER, "Expected event")));
     consume(TokenType::ARROW, "Expected arrow");
-    auto target = consume(TokenType::IDENTIFIER, "Expected target").value;
+    std::string target(lexeme(consume(TokenType::IDENTIFIER, "Expected target")));
     return std::make_unique<ConnectStmt>(source, event, target);
 }
 
@@ -528,7 +567,7 @@ std::unique_ptr<Stmt> Parser::parseTry() {
 
     consume(TokenType::CATCH, "Expected 'catch' after try block");
     consume(TokenType::LPAREN, "Expected '(' after catch");
-    std::string errorVar = consume(TokenType::IDENTIFIER, "Expected error variable name").value;
+    std::string errorVar(lexeme(consume(TokenType::IDENTIFIER, "Expected error variable name")));
     consume(TokenType::RPAREN, "Expected ')' after error variable");
 
     consume(TokenType::LBRACE, "Expected '{' start of catch block");
@@ -0,0 +1,113 @@
+#include "prefetch.h"
+#include <algorithm>
+#include <thread>
+#include "astcache.h"
+
+namespace {
+    // Semua ImportStmt, termasuk yang di dalam fungsi / method / blok
+    void collectImports(const std::vector<std::unique_ptr<Stmt>>& body, std::vector<std::string>& out) {
+        for (auto& stmt : body) {
+            Stmt* s = stmt.get();
+            if (auto imp = dynamic_cast<ImportStmt*>(s)) {
+                if (!imp->lazy) out.push_back(imp->path); // lazy import sengaja tidak dibaca di awal
+            }
+            else if (auto func = dynamic_cast<FuncDecl*>(s)) collectImports(func->body, out);
+            else if (auto cls = dynamic_cast<ClassDecl*>(s)) {
+                for (auto& method : cls->methods) collectImports(method->body, out);
+            }
+            else if (auto ifStmt = dynamic_cast<IfStmt*>(s)) {
+                collectImports(ifStmt->thenBranch, out);
+                collectImports(ifStmt->elseBranch, out);
+            }
+            else if (auto whileLoop = dynamic_cast<WhileStmt*>(s)) collectImports(whileLoop->body, out);
+            else if (auto loop = dynamic_cast<ForStmt*>(s)) collectImports(loop->body, out);
+            else if (auto tryStmt = dynamic_cast<TryStmt*>(s)) {
+                collectImports(tryStmt->tryBody, out);
+                collectImports(tryStmt->catchBody, out);
+            }
+            else if (auto app = dynamic_cast<AppDecl*>(s)) collectImports(app->body, out);
+            else if (auto window = dynamic_cast<WindowDecl*>(s)) collectImports(window->body, out);
+        }
+    }
+}
+
+void Prefetch::run(const Program& root, const std::string& rootPath) {
+    std::vector<std::string> imports;
+    collectImports(root.statements, imports);
+    if (imports.empty()) return;
+
+    std::unique_lock<std::mutex> guard(lock);
+    entries[Sys::canonicalPath(rootPath)]; // entry kosong: tidak di-parse, take() -> nullptr
+    schedule(imports);
+    if (queue.empty()) return;
+    guard.unlock();
+
+    unsigned threads = std::max(1u, std::min(std::thread::hardware_concurrency(), MAX_THREADS));
+    std::vector<std::thread> workers;
+    for (unsigned i = 1; i < threads; i++) workers.emplace_back([this] { work(); });
+    work(); // thread utama ikut bekerja
+    for (auto& worker : workers) worker.join();
+}
+
+void Prefetch::schedule(const std::vector<std::string>& paths) {
+    for (auto& path : paths) {
+        if (!Sys::fileExists(path)) continue; // Runtime yang melaporkan saat import dieksekusi
+        auto inserted = entries.try_emplace(Sys::canonicalPath(path));
+        if (!inserted.second) continue;
+        Entry& entry = inserted.first->second;
+        entry.path = path;
+        queue.push_back(&entry);
+    }
+}
+
+void Prefetch::work() {
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        changed.wait(guard, [this] { return !queue.empty() || active == 0; });
+        if (queue.empty()) break; // tidak ada antrian dan tidak ada worker yang bisa menambah
+
+        Entry* entry = queue.back();
+        queue.pop_back();
+        active++;
+        guard.unlock();
+
+        std::vector<std::string> imports;
+        parse(*entry, imports);
+
+        guard.lock();
+        schedule(imports);
+        active--;
+        changed.notify_all();
+    }
+}
+
+void Prefetch::parse(Entry& entry, std::vector<std::string>& imports) {
+    entry.size = Sys::fileSize(entry.path);
+    entry.mtime = Sys::fileTime(entry.path);
+    entry.source = std::make_unique<Sys::MappedFile>(entry.path);
+    entry.hash = AstCache::contentHash(entry.source->text());
+    try {
+        entry.program = AstCache::parse(entry.path, entry.source->text(), entry.cached);
+    } catch (...) {
+        entry.error = std::current_exception();
+        return;
+    }
+    collectImports(entry.program->statements, imports);
+}
+
+std::unique_ptr<Program> Prefetch::take(const std::string& canonicalPath) {
+    auto it = entries.find(canonicalPath);
+    if (it == entries.end()) return nullptr;
+    Entry entry = std::move(it->second);
+    entries.erase(it);
+
+    if (!entry.source) return nullptr;
+    // Script bisa menulis ulang modul sebelum meng-import-nya: hasil prefetch sudah basi
+    // (mtime bisa sama kalau ditulis dalam detik yang sama, jadi isinya juga dibandingkan)
+    if (Sys::fileSize(entry.path) != entry.size || Sys::fileTime(entry.path) != entry.mtime) return nullptr;
+    Sys::MappedFile current(entry.path);
+    if (AstCache::contentHash(current.text()) != entry.hash) return nullptr;
+    if (entry.error) std::rethrow_exception(entry.error);
+    if (!entry.cached) AstCache::finish(entry.path, current.text(), *entry.program);
+    return std::move(entry.program);
+}
@@ -0,0 +1,224 @@
+#include "resolver.h"
+#include "builtins.h"
+#include "intern.h"
+
+void Resolver::resolve(Program& program) {
+    function = nullptr;
+    scopes.clear();
+    resolveBlock(program.statements);
+}
+
+// Kumpulkan nama yang di-define di sebuah scope (tanpa masuk ke catch / func / class)
+void Resolver::declare(const std::vector<std::unique_ptr<Stmt>>& body, std::vector<std::string>& names) {
+    for (auto& stmtPtr : body) {
+        Stmt* stmt = stmtPtr.get();
+        if (auto set = dynamic_cast<SetStmt*>(stmt)) names.push_back(set->name);
+        else if (auto cls = dynamic_cast<ClassDecl*>(stmt)) names.push_back(cls->name);
+        else if (auto loop = dynamic_cast<ForStmt*>(stmt)) {
+            names.push_back(loop->iteratorName);
+            declare(loop->body, names);
+        }
+        else if (auto ifStmt = dynamic_cast<IfStmt*>(stmt)) {
+            declare(ifStmt->thenBranch, names);
+            declare(ifStmt->elseBranch, names);
+        }
+        else if (auto whileLoop = dynamic_cast<WhileStmt*>(stmt)) declare(whileLoop->body, names);
+        else if (auto tryStmt = dynamic_cast<TryStmt*>(stmt)) declare(tryStmt->tryBody, names);
+        else if (auto app = dynamic_cast<AppDecl*>(stmt)) declare(app->body, names);
+        else if (auto window = dynamic_cast<WindowDecl*>(stmt)) declare(window->body, names);
+    }
+}
+
+int Resolver::newSlot(int parent) {
+    if (!function) return globals.hiddenSlot(parent);
+    function->slotParents.push_back(parent);
+    return function->frameSize++;
+}
+
+// Slot terdekat untuk 'name' di frame aktif, -1 kalau tidak ada
+int Resolver::outerSlot(const std::string& name) {
+    for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
+        auto found = it->find(name);
+        if (found != it->end()) return found->second;
+    }
+    if (!function) return globals.slotFor(name);
+    return -1;
+}
+
+void Resolver::pushScope(const std::vector<std::string>& names) {
+    Scope scope;
+    for (auto& name : names) {
+        if (scope.count(name)) continue;
+        scope[name] = newSlot(outerSlot(name));
+    }
+    scopes.push_back(std::move(scope));
+}
+
+SlotRef Resolver::reference(const std::string& name) {
+    SlotRef ref;
+    ref.global = globals.slotFor(name);
+    for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
+        auto found = it->find(name);
+        if (found != it->end()) {
+            ref.local = found->second;
+            break;
+        }
+    }
+    return ref;
+}
+
+SlotRef Resolver::definition(const std::string& name) {
+    SlotRef ref;
+    ref.global = globals.slotFor(name);
+    if (!scopes.empty()) ref.local = scopes.back().at(name);
+    return ref;
+}
+
+// Builtin menang atas fungsi user dengan nama sama (urutan lama di Runtime)
+void Resolver::bindCall(const std::string& name, int& builtin, int& function) {
+    builtin = Builtins::find(name);
+    function = builtin < 0 ? globals.functionSlot(name) : -1;
+}
+
+void Resolver::resolveFunction(FuncDecl* fn, bool isMethod) {
+    FuncDecl* enclosingFunction = function;
+    std::vector<Scope> enclosingScopes = std::move(scopes);
+    int enclosingTryDepth = tryDepth;
+    function = fn;
+    scopes.clear();
+    tryDepth = 0;
+    fn->frameSize = 0;
+    fn->slotParents.clear();
+
+    Scope scope;
+    for (auto& param : fn->params) {
+        if (!scope.count(param)) scope[param] = newSlot(-1);
+        else newSlot(-1); // param dobel tetap makan slot supaya index argumen = index slot
+    }
+    if (isMethod) {
+        if (!scope.count("this")) scope["this"] = newSlot(-1);
+        fn->thisSlot = scope["this"];
+    }
+    std::vector<std::string> names;
+    declare(fn->body, names);
+    for (auto& name : names) {
+        if (!scope.count(name)) scope[name] = newSlot(-1);
+    }
+    scopes.push_back(std::move(scope));
+
+    resolveBlock(fn->body);
+
+    function = enclosingFunction;
+    scopes = std::move(enclosingScopes);
+    tryDepth = enclosingTryDepth;
+}
+
+void Resolver::resolveBlock(const std::vector<std::unique_ptr<Stmt>>& body) {
+    for (auto& s : body) resolveStmt(s.get());
+}
+
+void Resolver::resolveStmt(Stmt* stmt) {
+    if (!stmt) return;
+
+    if (auto set = dynamic_cast<SetStmt*>(stmt)) {
+        resolveExpr(set->expression.get());
+        set->ref = definition(set->name);
+    }
+    else if (auto up = dynamic_cast<UpdateStmt*>(stmt)) up->ref = reference(up->name);
+    else if (auto exprStmt = dynamic_cast<ExprStmt*>(stmt)) resolveExpr(exprStmt->expression.get());
+    else if (auto call = dynamic_cast<CallStmt*>(stmt)) {
+        bindCall(call->func, call->builtin, call->function);
+        for (auto& arg : call->args) resolveExpr(arg.get());
+    }
+    else if (auto ret = dynamic_cast<ReturnStmt*>(stmt)) {
+        resolveExpr(ret->value.get());
+        auto call = dynamic_cast<CallExpr*>(ret->value.get());
+        ret->tail = function && tryDepth == 0 && call && call->builtin < 0 && call->function >= 0;
+    }
+    else if (auto ifStmt = dynamic_cast<IfStmt*>(stmt)) {
+        resolveExpr(ifStmt->condition.get());
+        resolveBlock(ifStmt->thenBranch);
+        resolveBlock(ifStmt->elseBranch);
+    }
+    else if (auto whileLoop = dynamic_cast<WhileStmt*>(stmt)) {
+        resolveExpr(whileLoop->condition.get());
+        resolveBlock(whileLoop->body);
+    }
+    else if (auto loop = dynamic_cast<ForStmt*>(stmt)) {
+        resolveExpr(loop->collection.get());
+        loop->ref = definition(loop->iteratorName);
+        resolveBlock(loop->body);
+    }
+    else if (auto tryStmt = dynamic_cast<TryStmt*>(stmt)) {
+        tryDepth++;
+        resolveBlock(tryStmt->tryBody);
+        tryDepth--;
+
+        std::vector<std::string> names{tryStmt->errorVar};
+        declare(tryStmt->catchBody, names);
+        pushScope(names);
+        tryStmt->errorSlot = scopes.back().at(tryStmt->errorVar);
+        tryStmt->scopeSlots.clear();
+        for (auto& entry : scopes.back()) tryStmt->scopeSlots.push_back(entry.second);
+        resolveBlock(tryStmt->catchBody);
+        scopes.pop_back();
+    }
+    else if (auto func = dynamic_cast<FuncDecl*>(stmt)) {
+        func->slot = globals.functionSlot(func->name);
+        resolveFunction(func, false);
+    }
+    else if (auto cls = dynamic_cast<ClassDecl*>(stmt)) {
+        cls->ref = definition(cls->name);
+        for (auto& method : cls->methods) resolveFunction(method.get(), true);
+    }
+    else if (auto app = dynamic_cast<AppDecl*>(stmt)) resolveBlock(app->body);
+    else if (auto window = dynamic_cast<WindowDecl*>(stmt)) resolveBlock(window->body);
+}
+
+void Resolver::resolveExpr(Expr* expr) {
+    if (!expr) return;
+
+    if (auto var = dynamic_cast<VariableExpr*>(expr)) var->ref = reference(var->name);
+    else if (auto str = dynamic_cast<StringExpr*>(expr)) {
+        if (str->constant.isNil()) str->constant = Intern::get(str->value);
+    }
+    else if (auto self = dynamic_cast<ThisExpr*>(expr)) self->ref = reference("this");
+    else if (auto bin = dynamic_cast<BinaryExpr*>(expr)) {
+        resolveExpr(bin->lhs.get());
+        resolveExpr(bin->rhs.get());
+    }
+    else if (auto call = dynamic_cast<CallExpr*>(expr)) {
+        bindCall(call->func, call->builtin, call->function);
+        for (auto& arg : call->args) resolveExpr(arg.get());
+    }
+    else if (auto methodCall = dynamic_cast<MethodCallExpr*>(expr)) {
+        resolveExpr(methodCall->object.get());
+        for (auto& arg : methodCall->args) resolveExpr(arg.get());
+    }
+    else if (auto newExpr = dynamic_cast<NewExpr*>(expr)) {
+        newExpr->ref = reference(newExpr->className);
+        for (auto& arg : newExpr->args) resolveExpr(arg.get());
+    }
+    else if (auto get = dynamic_cast<GetExpr*>(expr)) {
+        get->key = get->name.key();
+        resolveExpr(get->object.get());
+    }
+    else if (auto set = dynamic_cast<SetExpr*>(expr)) {
+        set->key = set->name.key();
+        resolveExpr(set->object.get());
+        resolveExpr(set->value.get());
+    }
+    else if (auto arr = dynamic_cast<ArrayExpr*>(expr)) {
+        for (auto& el : arr->elements) resolveExpr(el.get());
+    }
+    else if (auto dict = dynamic_cast<DictExpr*>(expr)) {
+        for (auto& p : dict->pairs) {
+            resolveExpr(p.first.get());
+            resolveExpr(p.second.get());
+        }
+    }
+    else if (auto idx = dynamic_cast<IndexExpr*>(expr)) {
+        resolveExpr(idx->object.get());
+        resolveExpr(idx->index.get());
+    }
+}
@@ -7,8 +7,6 @@
 #include <algorithm>
 #include <cmath>
 #include <sstream>
-#include <thread>
-#include <chrono>
 
 // INCLUDE HEADER
 #include "types.h"  
@@ -16,45 +14,564 @@
 #include "lexer.h" 
 #include "parser.h" 
 #include "os.h" 
-#include "link_str.h"
-#include "link_math.h"
+#include "bytecode.h"
+#include "resolver.h"
+#include "builtins.h"
+#include "jit.h"
+#include "ops.h"
+#include "optimizer.h"
+#include "memo.h"
+#include "gc.h"
+#include "astcache.h"
+#include "module.h"
+#include "prefetch.h"
+#include "image.h"
 
 class Runtime {
 public:
-    Runtime() {
-        globalEnv = std::make_shared<Environment>();
-        currentEnv = globalEnv;
+    Runtime(Engine e = Engine::Walker, bool useJit = false) : engine(e) {
+        globalEnv = std::make_unique<Environment>(0, &globals.parents);
+        currentEnv = globalEnv.get();
+        if (useJit && Jit::supported()) jit = std::make_unique<Jit>(functionRegistry);
     }
     
-    void execute(std::unique_ptr<Program> program) {
-        if (!program) return;
+    // path = file script utama (kosong untuk REPL): didaftarkan sebagai modul supaya
+    // import balik ke script utama terdeteksi sebagai import melingkar
+    // false kalau terjadi runtime error
+    bool execute(std::unique_ptr<Program> program, const std::string& path = "") {
+        if (!program) return true;
         
+        resolveProgram(*program);
         loadedPrograms.push_back(std::move(program));
-        
-        for (auto& stmt : loadedPrograms.back()->statements) { 
-            runStatement(stmt.get()); 
+        Module* main = nullptr;
+        if (!path.empty()) {
+            prefetch.run(*loadedPrograms.back(), path);
+            main = &modules.begin(Sys::canonicalPath(path), path, loadedPrograms.back().get());
+        }
+        Completion done = runProgram(loadedPrograms.back().get());
+        if (main) finish(*main, done);
+        if (done == Completion::Error) {
+            std::cout << "Runtime Error: " << takeError() << "\n";
+            return false;
+        }
+        return true;
+    }
+
+    // --snapshot: state global setelah script selesai ditulis ke image (lihat image.h)
+    bool saveImage(const std::string& imagePath) {
+        Image::State state;
+        std::unordered_map<const Program*, uint32_t> programIndex;
+        for (auto& program : loadedPrograms) {
+            programIndex[program.get()] = (uint32_t)state.programs.size();
+            state.programs.push_back(program.get());
+        }
+        for (const Module* module : modules.list()) {
+            if (module->state == Module::State::Loading) continue;
+            Image::ModuleInfo info;
+            info.path = module->path;
+            info.name = module->name;
+            if (module->state == Module::State::Loaded) info.program = programIndex.at(module->program);
+            info.size = Sys::fileSize(module->path);
+            info.mtime = Sys::fileTime(module->path);
+            state.modules.push_back(info);
+        }
+        for (auto& entry : globals.functions) {
+            if (FuncDecl* fn = functionRegistry[entry.second]) state.functions.emplace_back(entry.first, fn);
+        }
+        for (auto& entry : globals.slots) {
+            // Variabel sementara optimizer selalu diisi ulang sebelum dipakai
+            if (!globalEnv->defined[entry.second] || Optimizer::isTemporary(entry.first)) continue;
+            state.globals.emplace_back(entry.first, globalEnv->slots[entry.second]);
+        }
+        if (!Image::save(imagePath, state)) {
+            std::cout << "Error: Cannot write image '" << imagePath << "'.\n";
+            return false;
         }
+        return true;
+    }
+
+    // --image: state dari image dipasang sebelum script jalan, tanpa menjalankan ulang library
+    bool loadImage(const std::string& imagePath) {
+        Image::State state;
+        std::string error;
+        if (!Image::load(imagePath, state, error)) {
+            std::cout << "Error: " << error << "\n";
+            return false;
+        }
+        std::vector<Program*> programs;
+        for (auto& program : state.owned) {
+            resolveProgram(*program);
+            programs.push_back(program.get());
+            loadedPrograms.push_back(std::move(program));
+        }
+        for (auto& function : state.functions) {
+            int slot = globals.functionSlot(function.first);
+            functionRegistry.resize(globals.functions.size(), nullptr);
+            functionRegistry[slot] = function.second;
+        }
+        for (auto& global : state.globals) {
+            int slot = globals.slotFor(global.first);
+            globalEnv->resize(globals.size());
+            globalEnv->define(slot, std::move(global.second));
+        }
+        // Stub lazy import dipasang terakhir: hanya untuk nama yang belum terisi, nama yang
+        // sudah terisi di image dianggap ditulis script (claim)
+        for (auto& info : state.modules) {
+            if (info.program == Image::NO_PROGRAM) deferModule(info.path, info.path, true);
+            else finish(modules.begin(info.path, info.name, programs[info.program]), Completion::Normal);
+        }
+        return true;
+    }
+
+    // Mode streaming (Parser::parseNext): program berisi satu statement top-level. Setelah jalan,
+    // program langsung dilepas kecuali berisi func/class yang masih bisa dipanggil nanti.
+    // false kalau terjadi runtime error (eksekusi berhenti seperti execute()).
+    bool executeStreamed(std::unique_ptr<Program> program) {
+        resolveProgram(*program);
+        Completion done = runProgram(program.get());
+        bool keep = false;
+        for (auto& stmt : program->statements) keep = keep || holdsDeclaration(stmt.get());
+        if (keep) loadedPrograms.push_back(std::move(program));
+        else chunks.erase(program.get());
+        if (done == Completion::Error) {
+            std::cout << "Runtime Error: " << takeError() << "\n";
+            return false;
+        }
+        return true;
     }
 
 private:
-    std::shared_ptr<Environment> globalEnv;
-    std::shared_ptr<Environment> currentEnv;
-    std::unordered_map<std::string, FuncDecl*> functionRegistry;
+    Engine engine;
+    GlobalTable globals;
+    std::unique_ptr<Environment> globalEnv;
+    Environment* currentEnv;
+
+    // Frame fungsi dipakai ulang secara LIFO; framePool[0..frameDepth) sedang aktif
+    std::vector<std::unique_ptr<Environment>> framePool;
+    size_t frameDepth = 0;
+    std::vector<FuncDecl*> functionRegistry; // index = FuncDecl::slot
     std::vector<std::unique_ptr<Program>> loadedPrograms;
+    ModuleRegistry modules; // import: tiap file dijalankan sekali
+    Prefetch prefetch;      // import yang sudah di-parse paralel sebelum script utama jalan
+    std::unordered_map<int, Module*> lazyGlobals;   // slot global -> modul lazy yang mendeklarasikannya
+    std::unordered_map<int, Module*> lazyFunctions; // slot functionRegistry -> modul lazy
+    std::unique_ptr<Jit> jit; // nullptr kalau --jit tidak dipakai
+
+    // Diisi saat Completion::Return / Completion::Error / Completion::TailCall
+    Obj returnValue;
+    FuncDecl* tailFunction = nullptr;
+    bool errorPending = false;
+    std::string errorMessage;
 
-    bool isTruthy(const Obj& val) {
-        if (std::holds_alternative<bool>(val.as)) return std::get<bool>(val.as);
-        if (std::holds_alternative<int>(val.as)) return std::get<int>(val.as) != 0;
-        if (std::holds_alternative<double>(val.as)) return std::get<double>(val.as) != 0.0;
-        if (std::holds_alternative<std::shared_ptr<List>>(val.as)) return !std::get<std::shared_ptr<List>>(val.as)->empty();
-        return false; 
+    // --- Bytecode VM state ---
+    struct CallFrame {
+        Chunk* chunk;
+        size_t ip;
+        size_t stackBase;
+        Environment* prevEnv;
+        Ref<LinkInstance> constructing; // frame init(): hasilnya instance, bukan return value
+        FuncDecl* memo = nullptr;       // memo func: argumennya tetap di stack[stackBase..] untuk key cache
+    };
+    struct TryHandler {
+        size_t frameCount;
+        size_t stackSize;
+        size_t catchIp;
+        TryStmt* node;
+        Environment* env;
+        size_t frameDepth;
+    };
+    std::vector<Obj> stack;
+    std::vector<CallFrame> frames;
+    std::vector<TryHandler> handlers;
+    std::unordered_map<const void*, std::unique_ptr<Chunk>> chunks;
+
+    static bool holdsDeclaration(Stmt* stmt) {
+        auto any = [](const std::vector<std::unique_ptr<Stmt>>& body) {
+            for (auto& s : body) if (holdsDeclaration(s.get())) return true;
+            return false;
+        };
+        if (dynamic_cast<FuncDecl*>(stmt) || dynamic_cast<ClassDecl*>(stmt)) return true;
+        if (auto ifStmt = dynamic_cast<IfStmt*>(stmt)) return any(ifStmt->thenBranch) || any(ifStmt->elseBranch);
+        if (auto whileLoop = dynamic_cast<WhileStmt*>(stmt)) return any(whileLoop->body);
+        if (auto loop = dynamic_cast<ForStmt*>(stmt)) return any(loop->body);
+        if (auto tryStmt = dynamic_cast<TryStmt*>(stmt)) return any(tryStmt->tryBody) || any(tryStmt->catchBody);
+        if (auto app = dynamic_cast<AppDecl*>(stmt)) return any(app->body);
+        if (auto window = dynamic_cast<WindowDecl*>(stmt)) return any(window->body);
+        return false;
+    }
+
+    void resolveProgram(Program& program) {
+        Resolver resolver(globals);
+        resolver.resolve(program);
+        globalEnv->resize(globals.size());
+        functionRegistry.resize(globals.functions.size(), nullptr);
+    }
+
+    // Modul yang sudah pernah di-import: export-nya sudah ada di scope global
+    Completion importKnown(Module& module) {
+        if (module.state == Module::State::Loaded) return Completion::Normal;
+        if (module.state == Module::State::Lazy) return loadModule(module);
+        fail("Circular import: " + modules.cycle(module));
+        return Completion::Error;
+    }
+
+    // Baca (hasil prefetch kalau ada), resolve lalu jalankan modul di scope global
+    Completion loadModule(Module& module) {
+        auto program = prefetch.take(module.path);
+        if (!program) {
+            Sys::MappedFile source(module.name);
+            program = AstCache::compile(module.name, source.text());
+        }
+        resolveProgram(*program);
+        loadedPrograms.push_back(std::move(program));
+        module.program = loadedPrograms.back().get();
+        dropStubs(module);
+        modules.start(module);
+
+        std::vector<Obj> keptGlobals;
+        std::vector<FuncDecl*> keptFunctions;
+        for (int slot : module.claimedGlobals) keptGlobals.push_back(globalEnv->slots[slot]);
+        for (int slot : module.claimedFunctions) keptFunctions.push_back(functionRegistry[slot]);
+
+        // Modul selalu jalan di scope global, walaupun import-nya ada di dalam fungsi
+        auto prevEnv = currentEnv;
+        currentEnv = globalEnv.get();
+        Completion done = runProgram(module.program);
+        currentEnv = prevEnv;
+        for (size_t i = 0; i < keptGlobals.size(); ++i) globalEnv->define(module.claimedGlobals[i], std::move(keptGlobals[i]));
+        for (size_t i = 0; i < keptFunctions.size(); ++i) setFunction(module.claimedFunctions[i], keptFunctions[i]);
+        module.claimedGlobals.clear();
+        module.claimedFunctions.clear();
+        finish(module, done);
+        return done == Completion::Error ? done : Completion::Normal; // return di top-level modul hanya menghentikan modul
+    }
+
+    // 'lazy import': nama yang dideklarasikan modul dipasang sebagai stub (slot global / fungsi
+    // yang belum terisi). Modul baru dimuat saat stub pertama kali dibaca atau dipanggil.
+    // claimDefined (image): nama yang sudah terisi juga di-claim, bukan cuma dilewati
+    void deferModule(const std::string& canonical, const std::string& path, bool claimDefined = false) {
+        std::vector<std::string> names, functionNames;
+        {
+            Sys::MappedFile source(path);
+            declaredNames(source.text(), names, functionNames);
+        }
+        Module& module = modules.defer(canonical, path);
+        for (auto& name : names) {
+            int slot = globals.slotFor(name);
+            globalEnv->resize(globals.size());
+            if (!globalEnv->defined[slot]) lazyGlobals.emplace(slot, &module);
+            else if (claimDefined) module.claimedGlobals.push_back(slot);
+        }
+        for (auto& name : functionNames) {
+            int slot = globals.functionSlot(name);
+            functionRegistry.resize(globals.functions.size(), nullptr);
+            if (!functionRegistry[slot]) lazyFunctions.emplace(slot, &module);
+            else if (claimDefined) module.claimedFunctions.push_back(slot);
+        }
     }
 
-    FuncDecl* findMethod(LinkClass* klass, const std::string& name) {
-        if (klass->methods.count(name)) {
-            return dynamic_cast<FuncDecl*>(klass->methods[name]);
+    void dropStubs(const Module& module) {
+        for (auto* stubs : {&lazyGlobals, &lazyFunctions}) {
+            for (auto it = stubs->begin(); it != stubs->end();) {
+                if (it->second == &module) it = stubs->erase(it);
+                else ++it;
+            }
         }
-        return nullptr;
+    }
+
+    // Stub lazy import tersentuh: modul pemiliknya dijalankan dulu. Error modul tetap pending,
+    // pemanggil lookup / function() mengeceknya seperti error ekspresi lain.
+    bool loadLazy(std::unordered_map<int, Module*>& stubs, int slot) {
+        auto it = stubs.find(slot);
+        if (it == stubs.end()) return false;
+        loadModule(*it->second);
+        return true;
+    }
+
+    // nullptr juga kalau modul lazy pemiliknya gagal dimuat (errorPending)
+    // Script menulis nama yang masih stub lazy: stub dilepas dan slotnya dicatat di modul,
+    // supaya saat modul itu dimuat nanti nilai script tidak tertimpa
+    void claimGlobal(int slot) {
+        auto it = lazyGlobals.find(slot);
+        if (it == lazyGlobals.end()) return;
+        it->second->claimedGlobals.push_back(slot);
+        lazyGlobals.erase(it);
+    }
+
+    void claimFunction(int slot) {
+        auto it = lazyFunctions.find(slot);
+        if (it == lazyFunctions.end()) return;
+        it->second->claimedFunctions.push_back(slot);
+        lazyFunctions.erase(it);
+    }
+
+    void setFunction(int slot, FuncDecl* func) {
+        // Kode JIT memanggil fungsi lain secara langsung, jadi definisi ulang membuang semuanya
+        FuncDecl* previous = functionRegistry[slot];
+        if (jit && previous != func) jit->invalidate();
+        if (previous && previous != func && previous->memo) Memo::clear();
+        functionRegistry[slot] = func;
+    }
+
+    FuncDecl* function(int slot) {
+        FuncDecl* fn = functionRegistry[slot];
+        if (!fn && !lazyFunctions.empty() && loadLazy(lazyFunctions, slot)) fn = errorPending ? nullptr : functionRegistry[slot];
+        return fn;
+    }
+
+    void finish(Module& module, Completion done) {
+        bool ok = done != Completion::Error;
+        if (ok) exportsOf(module);
+        modules.finish(module, ok);
+    }
+
+    const Obj& lookup(const SlotRef& ref) {
+        static const Obj nil;
+        int slot = currentEnv->find(ref.local);
+        if (slot >= 0) return currentEnv->slots[slot];
+        if (globalEnv->defined[ref.global]) return globalEnv->slots[ref.global];
+        if (!lazyGlobals.empty() && loadLazy(lazyGlobals, ref.global)) return lookup(ref);
+        return nil;
+    }
+
+    void define(const SlotRef& ref, Obj val) {
+        if (ref.local >= 0) currentEnv->define(ref.local, std::move(val));
+        else defineGlobal(ref.global, std::move(val));
+    }
+
+    void assign(const SlotRef& ref, Obj val) {
+        int slot = currentEnv->find(ref.local);
+        if (slot >= 0) currentEnv->slots[slot] = std::move(val);
+        else defineGlobal(ref.global, std::move(val));
+    }
+
+    void defineGlobal(int slot, Obj val) {
+        if (!lazyGlobals.empty()) claimGlobal(slot);
+        globalEnv->define(slot, std::move(val));
+    }
+
+    Environment* pushFrame(FuncDecl* fn) {
+        if (frameDepth == framePool.size()) framePool.push_back(std::make_unique<Environment>());
+        Environment* frame = framePool[frameDepth++].get();
+        frame->reset(fn->frameSize, &fn->slotParents);
+        return frame;
+    }
+
+    void popFrames(size_t depth) {
+        while (frameDepth > depth) framePool[--frameDepth]->release();
+    }
+
+    Completion runProgram(Program* program) {
+        if (engine == Engine::VM) return runChunk(chunkFor(program, program->statements, false));
+        return runBlock(program->statements);
+    }
+
+    Obj fail(const std::string& message) {
+        errorPending = true;
+        errorMessage = message;
+        return Obj();
+    }
+
+    std::string takeError() {
+        errorPending = false;
+        return std::move(errorMessage);
+    }
+
+    Chunk* chunkFor(const void* owner, const std::vector<std::unique_ptr<Stmt>>& body, bool isFunction) {
+        auto it = chunks.find(owner);
+        if (it != chunks.end()) return it->second.get();
+        Compiler compiler;
+        auto chunk = compiler.compile(body, isFunction);
+        Chunk* raw = chunk.get();
+        chunks[owner] = std::move(chunk);
+        return raw;
+    }
+
+    FuncDecl* findMethod(LinkClass* klass, const std::string& name, MethodCache& cache) {
+        if (cache.klass != klass->decl) {
+            auto it = klass->methods.find(name);
+            cache.klass = klass->decl;
+            cache.method = (it != klass->methods.end()) ? it->second : nullptr;
+        }
+        return cache.method;
+    }
+
+    Obj getField(LinkInstance* instance, GetExpr* node) {
+        FieldCache& cache = node->cache;
+        if (cache.shape != instance->shape) {
+            cache.shape = instance->shape;
+            cache.slot = instance->shape->find(node->key);
+        }
+        return cache.slot >= 0 ? instance->fields[cache.slot] : Obj();
+    }
+
+    void setField(LinkInstance* instance, SetExpr* node, Obj val) {
+        FieldCache& cache = node->cache;
+        if (cache.shape != instance->shape) {
+            cache.shape = instance->shape;
+            cache.slot = instance->shape->find(node->key);
+            cache.next = nullptr;
+            if (cache.slot < 0) {
+                cache.next = instance->shape->withField(node->key);
+                cache.slot = (int)instance->fields.size();
+            }
+        }
+        if (cache.next) {
+            instance->shape = cache.next;
+            instance->fields.push_back(std::move(val));
+        } else {
+            instance->fields[cache.slot] = std::move(val);
+        }
+    }
+
+    // Scope catch: slotnya dikosongkan dulu supaya tiap catch mulai bersih
+    void enterCatch(TryStmt* tryStmt, const std::string& message) {
+        for (int slot : tryStmt->scopeSlots) currentEnv->undefine(slot);
+        currentEnv->define(tryStmt->errorSlot, Obj(message));
+    }
+
+    // 'for x in range(...)' tanpa membuat list sama sekali
+    CallExpr* rangeCall(ForStmt* loop) {
+        static const int rangeId = Builtins::find("range");
+        auto call = dynamic_cast<CallExpr*>(loop->collection.get());
+        return (call && call->builtin == rangeId) ? call : nullptr;
+    }
+
+    // Iterator for baru saja di-define: slot lokalnya langsung ditulis, tanpa find() lewat rantai parent
+    void assignIterator(const SlotRef& ref, int value) {
+        if (ref.local >= 0 && currentEnv->defined[ref.local]) currentEnv->slots[ref.local] = Obj(value);
+        else assign(ref, Obj(value));
+    }
+
+    Completion runCounted(ForStmt* loop, int start, int step, int count) {
+        define(loop->ref, Obj(0));
+        for (int i = 0; i < count; ++i) {
+            assignIterator(loop->ref, start + i * step);
+            Completion done = runBlock(loop->body);
+            if (done != Completion::Normal) return done;
+        }
+        return Completion::Normal;
+    }
+
+    Obj indexValue(const Obj& object, const Obj& index) {
+        if (object.isList() && index.isInt()) {
+            List* list = object.asLazyList();
+            int i = index.asInt();
+            int size = (int)list->length();
+            if (i < 0) i += size; 
+            if (i >= 0 && i < size) return list->at(i);
+            std::cout << "Runtime Error: Index out of bounds\n";
+        } else if (object.isDict() && index.isString()) {
+            auto dict = object.asDict();
+            auto it = dict->find(index.asString());
+            if (it != dict->end()) return it->second;
+            return Obj();
+        }
+        return Obj();
+    }
+
+    Obj callNative(int id, const std::vector<std::unique_ptr<Expr>>& argExprs, bool asStatement) {
+        const Builtins::Native& native = Builtins::get(id);
+        Obj args[Builtins::MAX_ARITY];
+        int argc = std::min((int)argExprs.size(), native.arity);
+        for (int i = 0; i < argc; ++i) {
+            args[i] = evaluateExpr(argExprs[i].get());
+            if (errorPending) return Obj();
+        }
+        Builtins::NativeFn fn = (asStatement && native.stmtFn) ? native.stmtFn : native.fn;
+        Obj result = fn(args, argc);
+        if (Builtins::takeError(errorMessage)) errorPending = true;
+        return result;
+    }
+
+    // Argumen dievaluasi di env pemanggil langsung ke slot frame baru (tanpa vector sementara).
+    // Kalau gagal, frame sudah dilepas.
+    bool bindArgs(Environment* frame, FuncDecl* fn, const std::vector<std::unique_ptr<Expr>>& argExprs) {
+        for (size_t i = 0; i < argExprs.size(); ++i) {
+            Obj val = evaluateExpr(argExprs[i].get());
+            if (errorPending) {
+                popFrames(frameDepth - 1);
+                return false;
+            }
+            if (i < fn->params.size()) frame->define((int)i, std::move(val));
+        }
+        return true;
+    }
+
+    // Jalankan body fungsi di frame teratas pool, lalu kembali ke env pemanggil
+    Obj invoke(FuncDecl* fn, Environment* frame) {
+        Environment* previousEnv = currentEnv;
+        currentEnv = frame;
+        Completion done = runBlock(fn->body);
+        // Tail call: frame teratas sudah berisi argumen fungsi berikutnya, jalankan di sini tanpa rekursi C++
+        while (done == Completion::TailCall) {
+            fn = tailFunction;
+            currentEnv = framePool[frameDepth - 1].get();
+            if (jit && jit->call(fn, currentEnv->slots.data(), returnValue)) done = Completion::Return;
+            else done = runBlock(fn->body);
+        }
+        currentEnv = previousEnv;
+        popFrames(frameDepth - 1);
+        if (done == Completion::Return) return std::move(returnValue);
+        return Obj();
+    }
+
+    // 'return f(...)': argumen dievaluasi ke frame baru yang lalu menggantikan frame aktif di pool.
+    // false kalau harus lewat panggilan biasa (fungsi belum ada, jumlah argumen salah, bukan frame fungsi).
+    bool tailCall(CallExpr* call, Completion& done) {
+        FuncDecl* fn = function(call->function);
+        if (errorPending) {
+            done = Completion::Error;
+            return true;
+        }
+        if (!fn || fn->memo || call->args.size() != fn->params.size()) return false;
+        if (frameDepth == 0 || currentEnv != framePool[frameDepth - 1].get()) return false;
+        Environment* frame = pushFrame(fn);
+        if (!bindArgs(frame, fn, call->args)) {
+            done = Completion::Error;
+            return true;
+        }
+        std::swap(framePool[frameDepth - 1], framePool[frameDepth - 2]);
+        popFrames(frameDepth - 1);
+        tailFunction = fn;
+        done = Completion::TailCall;
+        return true;
+    }
+
+    // 'memo func': argumen dievaluasi dulu; kalau ada di cache tidak ada frame yang dibuat sama sekali
+    Obj callMemo(FuncDecl* fn, const std::vector<std::unique_ptr<Expr>>& argExprs) {
+        Obj args[Memo::MAX_ARGS];
+        int argc = (int)argExprs.size();
+        for (int i = 0; i < argc; ++i) {
+            args[i] = evaluateExpr(argExprs[i].get());
+            if (errorPending) return Obj();
+        }
+        Obj result;
+        if (Memo::lookup(fn, args, argc, result)) return result;
+        Environment* frame = pushFrame(fn);
+        for (int i = 0; i < argc; ++i) frame->define(i, args[i]);
+        result = invoke(fn, frame);
+        if (!errorPending) Memo::store(fn, args, argc, result);
+        return result;
+    }
+
+    Obj callFunction(FuncDecl* fn, const std::vector<std::unique_ptr<Expr>>& argExprs) {
+        if (argExprs.size() != fn->params.size()) {
+            std::cout << "Runtime Error: Function " << fn->name << " mismatch args.\n";
+            return Obj();
+        }
+        if (fn->memo && argExprs.size() <= (size_t)Memo::MAX_ARGS) return callMemo(fn, argExprs);
+
+        Environment* frame = pushFrame(fn);
+        if (!bindArgs(frame, fn, argExprs)) return Obj();
+        if (jit) {
+            Obj result;
+            if (jit->call(fn, frame->slots.data(), result)) {
+                popFrames(frameDepth - 1);
+                return result;
+            }
+        }
+        return invoke(fn, frame);
     }
 
     Obj evaluateExpr(Expr* expr) {
@@ -62,22 +579,27 @@ private:
         
         if (auto num = dynamic_cast<NumberExpr*>(expr)) return Obj(num->value);
         if (auto flt = dynamic_cast<FloatExpr*>(expr)) return Obj(flt->value);
-        if (auto str = dynamic_cast<StringExpr*>(expr)) return Obj(str->value);
+        if (auto str = dynamic_cast<StringExpr*>(expr)) return str->constant;
         if (auto chr = dynamic_cast<CharExpr*>(expr)) return Obj(chr->value);
         if (auto bl = dynamic_cast<BoolExpr*>(expr)) return Obj(bl->value);
-        if (auto var = dynamic_cast<VariableExpr*>(expr)) return currentEnv->get(var->name);
+        if (auto var = dynamic_cast<VariableExpr*>(expr)) return lookup(var->ref);
 
         if (auto arr = dynamic_cast<ArrayExpr*>(expr)) {
-            auto list = std::make_shared<List>();
-            for (auto& el : arr->elements) list->push_back(evaluateExpr(el.get()));
+            auto list = makeRef<List>();
+            for (auto& el : arr->elements) {
+                list->push_back(evaluateExpr(el.get()));
+                if (errorPending) return Obj();
+            }
             return Obj(list);
         }
         if (auto dictNode = dynamic_cast<DictExpr*>(expr)) {
-            auto dict = std::make_shared<Dict>();
+            auto dict = makeRef<Dict>();
             for (auto& p : dictNode->pairs) {
                 Obj key = evaluateExpr(p.first.get());
+                if (errorPending) return Obj();
                 Obj val = evaluateExpr(p.second.get());
-                if (std::holds_alternative<std::string>(key.as)) (*dict)[std::get<std::string>(key.as)] = val;
+                if (errorPending) return Obj();
+                if (key.isString()) (*dict)[key.asString()] = val;
                 else std::cout << "Runtime Error: Dict key must be string.\n";
             }
             return Obj(dict);
@@ -85,76 +607,54 @@ private:
 
         if (auto idx = dynamic_cast<IndexExpr*>(expr)) {
             Obj object = evaluateExpr(idx->object.get());
+            if (errorPending) return Obj();
             Obj index = evaluateExpr(idx->index.get());
-            if (std::holds_alternative<std::shared_ptr<List>>(object.as) && std::holds_alternative<int>(index.as)) {
-                auto list = std::get<std::shared_ptr<List>>(object.as);
-                int i = std::get<int>(index.as);
-                if (i < 0) i += list->size(); 
-                if (i >= 0 && i < (int)list->size()) return (*list)[i];
-                std::cout << "Runtime Error: Index out of bounds\n";
-            } else if (std::holds_alternative<std::shared_ptr<Dict>>(object.as) && std::holds_alternative<std::string>(index.as)) {
-                auto dict = std::get<std::shared_ptr<Dict>>(object.as);
-                std::string key = std::get<std::string>(index.as);
-                if (dict->count(key)) return (*dict)[key];
-                return Obj();
-            }
-            return Obj();
+            if (errorPending) return Obj();
+            return indexValue(object, index);
         }
 
         if (auto newExpr = dynamic_cast<NewExpr*>(expr)) {
-            Obj classObj = currentEnv->get(newExpr->className);
-            if (!std::holds_alternative<std::shared_ptr<LinkClass>>(classObj.as)) {
+            Obj classObj = lookup(newExpr->ref);
+            if (errorPending) return Obj();
+            if (!classObj.isClass()) {
                 std::cout << "Runtime Error: '" << newExpr->className << "' is not a class.\n";
                 return Obj();
             }
 
-            auto klass = std::get<std::shared_ptr<LinkClass>>(classObj.as);
-            auto instance = std::make_shared<LinkInstance>();
+            auto klass = classObj.asClass();
+            auto instance = makeRef<LinkInstance>();
             instance->klass = klass;
 
-            FuncDecl* init = findMethod(klass.get(), "init");
+            FuncDecl* init = klass->init;
             if (init) {
-                std::vector<Obj> args;
-                for (auto& arg : newExpr->args) args.push_back(evaluateExpr(arg.get()));
-
-                auto prevEnv = currentEnv;
-                currentEnv = std::make_shared<Environment>(globalEnv.get());
-                
-                currentEnv->define("this", Obj(instance));
-                for (size_t i = 0; i < init->params.size(); ++i) {
-                     if (i < args.size()) currentEnv->define(init->params[i], args[i]);
-                }
+                Environment* frame = pushFrame(init);
+                frame->define(init->thisSlot, Obj(instance));
+                if (!bindArgs(frame, init, newExpr->args)) return Obj();
 
-                try {
-                    for (auto& s : init->body) runStatement(s.get());
-                } catch (const ReturnException&) {} // Init tidak mengembalikan nilai
-                
-                currentEnv = prevEnv;
+                invoke(init, frame); // Init tidak mengembalikan nilai
+                if (errorPending) return Obj();
             }
             return Obj(instance);
         }
 
-        if (dynamic_cast<ThisExpr*>(expr)) {
-            return currentEnv->get("this");
+        if (auto self = dynamic_cast<ThisExpr*>(expr)) {
+            return lookup(self->ref);
         }
         if (auto get = dynamic_cast<GetExpr*>(expr)) {
             Obj obj = evaluateExpr(get->object.get());
-            if (std::holds_alternative<std::shared_ptr<LinkInstance>>(obj.as)) {
-                auto instance = std::get<std::shared_ptr<LinkInstance>>(obj.as);
-                if (instance->fields.count(get->name)) {
-                    return instance->fields[get->name];
-                }
-                return Obj(); 
-            }
+            if (errorPending) return Obj();
+            if (obj.isInstance()) return getField(obj.asInstance(), get);
             return Obj();
         }
 
         if (auto set = dynamic_cast<SetExpr*>(expr)) {
             Obj obj = evaluateExpr(set->object.get());
-            if (std::holds_alternative<std::shared_ptr<LinkInstance>>(obj.as)) {
-                auto instance = std::get<std::shared_ptr<LinkInstance>>(obj.as);
+            if (errorPending) return Obj();
+            if (obj.isInstance()) {
+                auto instance = obj.asInstance();
                 Obj val = evaluateExpr(set->value.get());
-                instance->fields[set->name] = val; 
+                if (errorPending) return Obj();
+                setField(instance, set, val); 
                 return val;
             }
             std::cout << "Runtime Error: Only instances have fields.\n";
@@ -163,198 +663,30 @@ private:
 
         if (auto methodCall = dynamic_cast<MethodCallExpr*>(expr)) {
             Obj obj = evaluateExpr(methodCall->object.get());
-            if (!std::holds_alternative<std::shared_ptr<LinkInstance>>(obj.as)) {
+            if (errorPending) return Obj();
+            if (!obj.isInstance()) {
                 std::cout << "Runtime Error: Method call on non-instance.\n";
                 return Obj();
             }
 
-            auto instance = std::get<std::shared_ptr<LinkInstance>>(obj.as);
-            FuncDecl* method = findMethod(instance->klass.get(), methodCall->method);
+            auto instance = obj.asInstance();
+            FuncDecl* method = findMethod(instance->klass.get(), methodCall->method, methodCall->cache);
             
             if (!method) {
                 std::cout << "Runtime Error: Method '" << methodCall->method << "' not found.\n";
                 return Obj();
             }
 
-            std::vector<Obj> args;
-            for (auto& arg : methodCall->args) args.push_back(evaluateExpr(arg.get()));
-
-            auto prevEnv = currentEnv;
-            currentEnv = std::make_shared<Environment>(globalEnv.get());
-
-            currentEnv->define("this", Obj(instance));
-            for (size_t i = 0; i < method->params.size(); ++i) {
-                if (i < args.size()) currentEnv->define(method->params[i], args[i]);
-            }
+            Environment* frame = pushFrame(method);
+            frame->define(method->thisSlot, Obj(instance));
+            if (!bindArgs(frame, method, methodCall->args)) return Obj();
 
-            try {
-                for (auto& s : method->body) runStatement(s.get());
-            } catch (const ReturnException& e) {
-                currentEnv = prevEnv;
-                return e.value;
-            }
-
-            currentEnv = prevEnv;
-            return Obj();
+            return invoke(method, frame);
         }
 
         if (auto call = dynamic_cast<CallExpr*>(expr)) {
-			
-			if (call->func == "time.sleep") {
-                if (call->args.empty()) return Obj();
-
-                Obj val = evaluateExpr(call->args[0].get());
-                int ms = 0;
-                
-                if (std::holds_alternative<int>(val.as)) ms = std::get<int>(val.as);
-                else if (std::holds_alternative<double>(val.as)) ms = (int)std::get<double>(val.as);
-
-                std::this_thread::sleep_for(std::chrono::milliseconds(ms));
-                return Obj();
-            }
-
-            if (call->func == "range") {
-                if (call->args.empty()) return Obj();
-                Obj limitObj = evaluateExpr(call->args[0].get());
-                int limit = 0;
-                if (std::holds_alternative<int>(limitObj.as)) limit = std::get<int>(limitObj.as);
-                auto list = std::make_shared<List>();
-                for (int i = 0; i < limit; i++) list->push_back(Obj(i));
-                return Obj(list);
-            }
-            if (call->func == "len" || call->func == "str.len") {
-                if (call->args.empty()) return Obj(0);
-                Obj target = evaluateExpr(call->args[0].get());
-                if (std::holds_alternative<std::string>(target.as)) return Obj((int)std::get<std::string>(target.as).length());
-                if (std::holds_alternative<std::shared_ptr<List>>(target.as)) return Obj((int)std::get<std::shared_ptr<List>>(target.as)->size());
-                return Obj(0);
-            }
-            if (call->func == "io.read") {
-                if (call->args.empty()) return Obj("");
-                Obj pathObj = evaluateExpr(call->args[0].get()); 
-                if (std::holds_alternative<std::string>(pathObj.as)) {
-                    std::string path = std::get<std::string>(pathObj.as);
-                    if (!Sys::fileExists(path)) throw RuntimeException("File not found: " + path);
-                    return Obj(Sys::readFile(path));
-                }
-                return Obj("");
-            }
-            if (call->func == "io.exists") {
-                if (call->args.empty()) return Obj(false);
-                Obj path = evaluateExpr(call->args[0].get());
-                if (std::holds_alternative<std::string>(path.as)) return Obj(Sys::fileExists(std::get<std::string>(path.as)));
-                return Obj(false);
-            }
-            if (call->func == "os.exec") {
-                if (call->args.empty()) return Obj("");
-                Obj cmd = evaluateExpr(call->args[0].get());
-                if (std::holds_alternative<std::string>(cmd.as)) return Obj(Sys::exec(std::get<std::string>(cmd.as).c_str()));
-                return Obj("");
-            }
-            if (call->func == "os.getenv") {
-                if (call->args.empty()) return Obj(""); 
-                Obj key = evaluateExpr(call->args[0].get());
-                if (std::holds_alternative<std::string>(key.as)) return Obj(Sys::getEnv(std::get<std::string>(key.as))); 
-                return Obj(""); 
-            }
-
-            if (call->func == "str.trim") {
-                if (call->args.empty()) return Obj("");
-                Obj s = evaluateExpr(call->args[0].get());
-                if (std::holds_alternative<std::string>(s.as)) return Obj(SysString::trim(std::get<std::string>(s.as)));
-                return s;
-            }
-            if (call->func == "str.replace") {
-                if (call->args.size() < 3) return Obj("");
-                Obj s = evaluateExpr(call->args[0].get());
-                Obj t = evaluateExpr(call->args[1].get());
-                Obj r = evaluateExpr(call->args[2].get());
-                if (std::holds_alternative<std::string>(s.as) && std::holds_alternative<std::string>(t.as) && std::holds_alternative<std::string>(r.as))
-                    return Obj(SysString::replace(std::get<std::string>(s.as), std::get<std::string>(t.as), std::get<std::string>(r.as)));
-                return s;
-            }
-            if (call->func == "str.split") {
-                 if (call->args.size() < 2) return Obj(std::make_shared<List>());
-                 Obj s = evaluateExpr(call->args[0].get());
-                 Obj d = evaluateExpr(call->args[1].get());
-                 auto list = std::make_shared<List>();
-                 if (std::holds_alternative<std::string>(s.as) && std::holds_alternative<std::string>(d.as)) {
-                     auto vec = SysString::split(std::get<std::string>(s.as), std::get<std::string>(d.as));
-                     for(const auto& v : vec) list->push_back(Obj(v));
-                 }
-                 return Obj(list);
-            }
-            if (call->func == "str.merge") {
-                if (call->args.size() < 2) return Obj("");
-                Obj l = evaluateExpr(call->args[0].get());
-                Obj d = evaluateExpr(call->args[1].get());
-                if (std::holds_alternative<std::shared_ptr<List>>(l.as) && std::holds_alternative<std::string>(d.as)) {
-                    std::vector<std::string> vs;
-                    auto lst = std::get<std::shared_ptr<List>>(l.as);
-                    for(auto& i : *lst) {
-                        if(std::holds_alternative<std::string>(i.as)) vs.push_back(std::get<std::string>(i.as));
-                        else if(std::holds_alternative<int>(i.as)) vs.push_back(std::to_string(std::get<int>(i.as)));
-                        else if(std::holds_alternative<double>(i.as)) vs.push_back(std::to_string(std::get<double>(i.as)));
-                    }
-                    return Obj(SysString::merge(vs, std::get<std::string>(d.as)));
-                }
-                return Obj("");
-            }
-            if (call->func == "str.contains") {
-                if (call->args.size() < 2) return Obj(false);
-                Obj h = evaluateExpr(call->args[0].get());
-                Obj n = evaluateExpr(call->args[1].get());
-                if (std::holds_alternative<std::string>(h.as) && std::holds_alternative<std::string>(n.as)) 
-                    return Obj(Sys::contains(std::get<std::string>(h.as), std::get<std::string>(n.as)));
-                return Obj(false);
-            }
-
-            auto getDouble = [&](Expr* e) -> double {
-                Obj o = evaluateExpr(e);
-                if (std::holds_alternative<double>(o.as)) return std::get<double>(o.as);
-                if (std::holds_alternative<int>(o.as)) return (double)std::get<int>(o.as);
-                return 0.0;
-            };
-
-            if (call->func == "math.pi") return Obj(SysMath::pi());
-            if (call->func == "math.sin") return Obj(SysMath::sin(getDouble(call->args[0].get())));
-            if (call->func == "math.cos") return Obj(SysMath::cos(getDouble(call->args[0].get())));
-            if (call->func == "math.tan") return Obj(SysMath::tan(getDouble(call->args[0].get())));
-            if (call->func == "math.sqrt") return Obj(SysMath::sqrt(getDouble(call->args[0].get())));
-            if (call->func == "math.abs") return Obj(SysMath::abs(getDouble(call->args[0].get())));
-            if (call->func == "math.pow") {
-                 if (call->args.size() >= 2) return Obj(SysMath::pow(getDouble(call->args[0].get()), getDouble(call->args[1].get())));
-                 return Obj(0.0);
-            }
-
-            if (functionRegistry.count(call->func)) {
-                FuncDecl* fn = functionRegistry[call->func];
-                if (call->args.size() != fn->params.size()) {
-                    std::cout << "Runtime Error: Function " << fn->name << " mismatch args.\n";
-                    return Obj();
-                }
-
-                std::vector<Obj> argValues;
-                for (auto& arg : call->args) argValues.push_back(evaluateExpr(arg.get()));
-
-                auto previousEnv = currentEnv;
-                currentEnv = std::make_shared<Environment>(globalEnv.get());
-
-                for (size_t i = 0; i < fn->params.size(); ++i) {
-                    currentEnv->define(fn->params[i], argValues[i]);
-                }
-
-                try {
-                    for (auto& s : fn->body) runStatement(s.get());
-                } catch (const ReturnException& e) {
-                    currentEnv = previousEnv; 
-                    return e.value;
-                }
-
-                currentEnv = previousEnv;
-                return Obj();
-            }
-
+            if (call->builtin >= 0) return callNative(call->builtin, call->args, false);
+            if (FuncDecl* fn = function(call->function)) return callFunction(fn, call->args);
             return Obj(); 
         }
 
@@ -370,45 +702,25 @@ private:
 
         if (auto bin = dynamic_cast<BinaryExpr*>(expr)) {
             Obj left = evaluateExpr(bin->lhs.get());   
+            if (errorPending) return Obj();
             Obj right = evaluateExpr(bin->rhs.get());  
-            
-            if (std::holds_alternative<std::string>(left.as)) {
-                std::string sLeft = std::get<std::string>(left.as);
-                std::string sRight = "";
-                if (std::holds_alternative<std::string>(right.as)) sRight = std::get<std::string>(right.as);
-                else if (std::holds_alternative<int>(right.as)) sRight = std::to_string(std::get<int>(right.as));
-                else if (std::holds_alternative<double>(right.as)) {
-                    std::ostringstream oss;
-                    oss << std::get<double>(right.as);
-                    sRight = oss.str();
-                }
-                if (bin->op == '+') return Obj(sLeft + sRight);
-            }
-
-            if (std::holds_alternative<int>(left.as) && std::holds_alternative<int>(right.as)) {
-                int l = std::get<int>(left.as), r = std::get<int>(right.as);
-                switch (bin->op) {
-                    case '+': return Obj(l + r); case '-': return Obj(l - r);
-                    case '*': return Obj(l * r); case '/': return Obj((r != 0) ? l / r : 0);
-                    case '<': return Obj(l < r); case '>': return Obj(l > r); case '=': return Obj(l == r);
-                }
-            } else if ((std::holds_alternative<double>(left.as)||std::holds_alternative<int>(left.as)) && (std::holds_alternative<double>(right.as)||std::holds_alternative<int>(right.as))) {
-                double l = std::holds_alternative<int>(left.as)?std::get<int>(left.as):std::get<double>(left.as);
-                double r = std::holds_alternative<int>(right.as)?std::get<int>(right.as):std::get<double>(right.as);
-                switch (bin->op) {
-                    case '+': return Obj(l + r); case '-': return Obj(l - r);
-                    case '*': return Obj(l * r); case '/': return Obj((r != 0.0) ? l / r : 0.0);
-                    case '<': return Obj(l < r); case '>': return Obj(l > r); case '=': return Obj(l == r);
-                }
-            } else if (std::holds_alternative<std::string>(left.as) && std::holds_alternative<std::string>(right.as)) {
-                if (bin->op == '=') return Obj(std::get<std::string>(left.as) == std::get<std::string>(right.as));
-            }
+            if (errorPending) return Obj();
+            return binaryOp(bin->op, left, right);
         }
         return Obj();
     }
 
-    void runStatement(Stmt* stmt) {
-        if (!stmt) return;
+    Completion runBlock(const std::vector<std::unique_ptr<Stmt>>& body) {
+        for (auto& s : body) {
+            if (Gc::pending) Gc::step();
+            Completion done = runStatement(s.get());
+            if (done != Completion::Normal) return done;
+        }
+        return Completion::Normal;
+    }
+
+    Completion runStatement(Stmt* stmt) {
+        if (!stmt) return Completion::Normal;
         
         if (dynamic_cast<ClearStmt*>(stmt)) {
             #ifdef _WIN32 
@@ -416,214 +728,595 @@ private:
             #else 
             system("clear"); 
             #endif
-            return; 
+            return Completion::Normal; 
         }
 
         if (auto cls = dynamic_cast<ClassDecl*>(stmt)) {
-            auto klass = std::make_shared<LinkClass>();
-            klass->name = cls->name;
-            for (auto& method : cls->methods) {
-                klass->methods[method->name] = method.get();
-            }
-            currentEnv->define(cls->name, Obj(klass));
-            return;
+            define(cls->ref, Obj(makeClass(cls)));
+            return Completion::Normal;
         }
 
         if (auto exprStmt = dynamic_cast<ExprStmt*>(stmt)) {
             evaluateExpr(exprStmt->expression.get());
-            return;
+            return errorPending ? Completion::Error : Completion::Normal;
         }
 
         if (auto tryStmt = dynamic_cast<TryStmt*>(stmt)) {
-            try {
-                for (auto& s : tryStmt->tryBody) runStatement(s.get());
-            } catch (const RuntimeException& e) {
-                auto prevEnv = currentEnv;
-                currentEnv = std::make_shared<Environment>(prevEnv.get());
-                currentEnv->define(tryStmt->errorVar, Obj(e.message));
-                for (auto& s : tryStmt->catchBody) runStatement(s.get());
-                currentEnv = prevEnv;
-            }
-            return;
+            auto tryEnv = currentEnv;
+            Completion done = runBlock(tryStmt->tryBody);
+            if (done != Completion::Error) return done;
+            currentEnv = tryEnv;
+            enterCatch(tryStmt, takeError());
+            return runBlock(tryStmt->catchBody);
         }
         
         if (auto ret = dynamic_cast<ReturnStmt*>(stmt)) {
+            if (ret->tail) {
+                Completion done;
+                if (tailCall(static_cast<CallExpr*>(ret->value.get()), done)) return done;
+            }
 			Obj result; 
 			if (ret->value) result = evaluateExpr(ret->value.get()); 
-			throw ReturnException(result); 
+			if (errorPending) return Completion::Error;
+			returnValue = std::move(result);
+			return Completion::Return; 
 		}
         
         if (auto set = dynamic_cast<SetStmt*>(stmt)) {
-            currentEnv->define(set->name, evaluateExpr(set->expression.get())); 
-            return;
+            Obj val = evaluateExpr(set->expression.get());
+            if (errorPending) return Completion::Error;
+            define(set->ref, std::move(val)); 
+            return Completion::Normal;
         }
 
         if (auto func = dynamic_cast<FuncDecl*>(stmt)) {
-            functionRegistry[func->name] = func;
-            return;
+            if (!lazyFunctions.empty()) claimFunction(func->slot);
+            setFunction(func->slot, func);
+            return Completion::Normal;
         }
         
         
         if (auto call = dynamic_cast<CallStmt*>(stmt)) {
-			
-			if (call->func == "time.sleep") {
-                if (!call->args.empty()) {
-                    Obj val = evaluateExpr(call->args[0].get());
-                    int ms = 0;
-                    if (std::holds_alternative<int>(val.as)) ms = std::get<int>(val.as);
-                    else if (std::holds_alternative<double>(val.as)) ms = (int)std::get<double>(val.as);
-                    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
-                }
-                return; 
-            }
-			
-            if (call->func == "io.write" || call->func == "io.append") { 
-                if (call->args.size() < 2) return;
-                Obj pathObj = evaluateExpr(call->args[0].get());
-                Obj contentObj = evaluateExpr(call->args[1].get());
-                if (std::holds_alternative<std::string>(pathObj.as)) {
-                    std::string path = std::get<std::string>(pathObj.as);
-                    std::string content = "";
-                    if (std::holds_alternative<std::string>(contentObj.as)) content = std::get<std::string>(contentObj.as);
-                    else if (std::holds_alternative<int>(contentObj.as)) content = std::to_string(std::get<int>(contentObj.as));
-                    else if (std::holds_alternative<double>(contentObj.as)) content = std::to_string(std::get<double>(contentObj.as));
-                    Sys::writeFile(path, content, (call->func == "io.append"));
-                }
-                return; 
-            }
-            if (call->func == "os.setenv") { 
-                if (call->args.size() < 2) return;
-                Obj key = evaluateExpr(call->args[0].get());
-                Obj val = evaluateExpr(call->args[1].get()); 
-                if (std::holds_alternative<std::string>(key.as) && std::holds_alternative<std::string>(val.as)) {
-                    Sys::setEnv(std::get<std::string>(key.as), std::get<std::string>(val.as)); 
-                }
-                return;
-            }
-            if (call->func == "io.remove") { 
-                if (call->args.empty()) return;
-                Obj pathObj = evaluateExpr(call->args[0].get());
-                if (std::holds_alternative<std::string>(pathObj.as)) Sys::removeFile(std::get<std::string>(pathObj.as));
-                return;
-            }
-            if (call->func == "list.add") { 
-                if (call->args.size() < 2) return;
-                Obj target = evaluateExpr(call->args[0].get());
-                Obj item = evaluateExpr(call->args[1].get());
-                if (std::holds_alternative<std::shared_ptr<List>>(target.as)) {
-                    std::get<std::shared_ptr<List>>(target.as)->push_back(item);
-                }
-                return;
-            }
-            if (call->func == "print") { 
-                if (!call->args.empty()) printObj(evaluateExpr(call->args[0].get())); 
-                std::cout << "\n";
-                return;
-            }
-            if (call->func == "os.exec") { 
-                if (!call->args.empty()) {
-                    Obj cmd = evaluateExpr(call->args[0].get());
-                    if (std::holds_alternative<std::string>(cmd.as)) system(std::get<std::string>(cmd.as).c_str());
-                }
-                return;
-            }
-            
-            if (functionRegistry.count(call->func)) { 
-                FuncDecl* fn = functionRegistry[call->func];
-                if (call->args.size() != fn->params.size()) {
-                    std::cout << "Runtime Error: Function " << fn->name << " mismatch args.\n";
-                    return; 
-                } 
-
-                std::vector<Obj> argValues;
-                for (auto& arg : call->args) argValues.push_back(evaluateExpr(arg.get()));
-       
-                auto previousEnv = currentEnv;
-                currentEnv = std::make_shared<Environment>(globalEnv.get());
-                
-                for (size_t i = 0; i < fn->params.size(); ++i) {
-                    currentEnv->define(fn->params[i], argValues[i]);
-                }
-                
-                try {
-					for (auto& s : fn->body) runStatement(s.get()); 
-				} catch (const ReturnException&) {
-					currentEnv = previousEnv; 
-					return; 
-				}
-                currentEnv = previousEnv; 
-                return;
-            }
-            return;
+            if (call->builtin >= 0) callNative(call->builtin, call->args, true);
+            else if (FuncDecl* fn = function(call->function)) callFunction(fn, call->args);
+            return errorPending ? Completion::Error : Completion::Normal;
         }
 
         if (auto ifStmt = dynamic_cast<IfStmt*>(stmt)) {
-            if (isTruthy(evaluateExpr(ifStmt->condition.get()))) {
-                for (auto& s : ifStmt->thenBranch) runStatement(s.get());
-            } else {
-                for (auto& s : ifStmt->elseBranch) runStatement(s.get());
-            }
-            return;
+            bool cond = isTruthy(evaluateExpr(ifStmt->condition.get()));
+            if (errorPending) return Completion::Error;
+            return runBlock(cond ? ifStmt->thenBranch : ifStmt->elseBranch);
         }
         if (auto whileLoop = dynamic_cast<WhileStmt*>(stmt)) {
-            while (isTruthy(evaluateExpr(whileLoop->condition.get()))) {
-                for (auto& s : whileLoop->body) runStatement(s.get());
+            for (;;) {
+                bool cond = isTruthy(evaluateExpr(whileLoop->condition.get()));
+                if (errorPending) return Completion::Error;
+                if (!cond) return Completion::Normal;
+                Completion done = runBlock(whileLoop->body);
+                if (done != Completion::Normal) return done;
             }
-            return;
         }
         if (auto loop = dynamic_cast<ForStmt*>(stmt)) {
+             if (CallExpr* range = rangeCall(loop)) {
+                 Obj args[Builtins::MAX_ARITY];
+                 int argc = std::min((int)range->args.size(), Builtins::get(range->builtin).arity);
+                 for (int i = 0; i < argc; ++i) {
+                     args[i] = evaluateExpr(range->args[i].get());
+                     if (errorPending) return Completion::Error;
+                 }
+                 int start, step, count;
+                 if (Builtins::rangeBounds(args, argc, start, step, count)) return runCounted(loop, start, step, count);
+                 std::cout << "Runtime Error: 'For' loop expects a list/range.\n";
+                 return Completion::Normal;
+             }
              Obj collection = evaluateExpr(loop->collection.get());
-             if (std::holds_alternative<std::shared_ptr<List>>(collection.as)) {
-                 auto list = std::get<std::shared_ptr<List>>(collection.as);
-                 currentEnv->define(loop->iteratorName, Obj(0)); 
+             if (errorPending) return Completion::Error;
+             if (collection.isList()) {
+                 List* list = collection.asLazyList();
+                 if (list->lazy) return runCounted(loop, list->start, list->step, list->count);
+                 define(loop->ref, Obj(0)); 
                  for (auto& item : *list) {
-                     currentEnv->assign(loop->iteratorName, item); 
-                     for (auto& s : loop->body) runStatement(s.get());
+                     assign(loop->ref, item); 
+                     Completion done = runBlock(loop->body);
+                     if (done != Completion::Normal) return done;
                  }
              } else {
                  std::cout << "Runtime Error: 'For' loop expects a list/range.\n";
              }
-             return;
+             return Completion::Normal;
         }
         if (auto up = dynamic_cast<UpdateStmt*>(stmt)) {
-            Obj val = currentEnv->get(up->name);
-            if (std::holds_alternative<int>(val.as)) {
-                currentEnv->assign(up->name, Obj(std::get<int>(val.as) + 1));
+            Obj val = lookup(up->ref);
+            if (errorPending) return Completion::Error;
+            if (val.isInt()) {
+                assign(up->ref, Obj(val.asInt() + 1));
             }
-            return;
+            return Completion::Normal;
         }
         if (auto prop = dynamic_cast<PropertyStmt*>(stmt)) {
             if (prop->name == "sh") {
                 int status = system(prop->value.c_str()); (void)status; 
             }
-            return;
+            return Completion::Normal;
         }
         if (auto app = dynamic_cast<AppDecl*>(stmt)) {
-            for (auto& s : app->body) runStatement(s.get());
-            return;
+            return runBlock(app->body);
         }
         
         // Import Logic (SAFE POINTER VERSION)
         if (auto imp = dynamic_cast<ImportStmt*>(stmt)) {
-             std::string path = imp->path;
-             if (!Sys::fileExists(path)) {
-                 std::cout << "Runtime Error: Cannot import '" << path << "'. File not found.\n";
-                 return;
-             }
-             std::string source = Sys::readFile(path);
-             Lexer lexer(source);
-             auto tokens = lexer.tokenize();
-             Parser parser(tokens);
-             auto importedProgram = parser.parse();
-             
-             if (importedProgram) {
-                 loadedPrograms.push_back(std::move(importedProgram));
-                 Program* storedProgram = loadedPrograms.back().get();
-                 for (auto& s : storedProgram->statements) {
-                     runStatement(s.get());
+             const std::string& path = imp->path;
+             // Import ulang (mis. di dalam fungsi / loop) cukup satu lookup, tanpa baca file
+             Module* known = imp->canonical.empty() ? nullptr : modules.find(imp->canonical);
+             if (!known) {
+                 if (!Sys::fileExists(path)) {
+                     std::cout << "Runtime Error: Cannot import '" << path << "'. File not found.\n";
+                     return Completion::Normal;
                  }
+                 imp->canonical = Sys::canonicalPath(path);
+                 known = modules.find(imp->canonical);
              }
-             return;
+             if (known) return imp->lazy ? Completion::Normal : importKnown(*known);
+             if (imp->lazy) {
+                 deferModule(imp->canonical, path);
+                 return Completion::Normal;
+             }
+             return loadModule(modules.defer(imp->canonical, path));
         }
+        return Completion::Normal;
 	}
+
+    // --- Bytecode VM ---
+    // Satu loop dispatch untuk semua frame; panggilan fungsi Link tidak menumpuk stack C++.
+    // Node yang belum punya opcode sendiri dijalankan lewat EVAL_EXPR / EXEC_STMT (tree-walker).
+    // Error (native / fallback) melompat ke 'unwind' dan dicocokkan dengan TryHandler terdekat.
+    Completion runChunk(Chunk* entry) {
+        size_t entryDepth = frames.size();
+        size_t handlerBase = handlers.size();
+        size_t frameBase = frameDepth;
+        frames.push_back(CallFrame{entry, 0, stack.size(), currentEnv, nullptr});
+
+        Chunk* chunk = entry;
+        size_t ip = 0;
+
+        auto readOperand = [&]() -> uint32_t {
+            uint32_t v = chunk->readOperand(ip);
+            ip += sizeof(uint32_t);
+            return v;
+        };
+        auto readRef = [&]() -> SlotRef {
+            SlotRef ref;
+            ref.local = (int32_t)readOperand();
+            ref.global = (int32_t)readOperand();
+            return ref;
+        };
+        auto pop = [&]() -> Obj {
+            Obj v = std::move(stack.back());
+            stack.pop_back();
+            return v;
+        };
+
+#if defined(__GNUC__)
+        static void* dispatchTable[] = {
+            &&op_CONST, &&op_NIL, &&op_POP,
+            &&op_GET_VAR, &&op_DEFINE_VAR, &&op_INCR_VAR,
+            &&op_ADD, &&op_SUB, &&op_MUL, &&op_DIV, &&op_LT, &&op_GT, &&op_EQ,
+            &&op_JUMP, &&op_JUMP_IF_FALSE,
+            &&op_BUILD_LIST, &&op_BUILD_DICT, &&op_INDEX,
+            &&op_GET_FIELD, &&op_SET_FIELD,
+            &&op_CALL_NATIVE, &&op_CALL, &&op_TAIL_CALL, &&op_INVOKE, &&op_NEW,
+            &&op_FOR_PREP, &&op_FOR_NEXT, &&op_RANGE_PREP, &&op_RANGE_NEXT,
+            &&op_TRY_BEGIN, &&op_TRY_END,
+            &&op_EVAL_EXPR, &&op_EXEC_STMT,
+            &&op_RETURN, &&op_HALT
+        };
+        // Computed goto tidak menjalankan destruktor: jangan biarkan Obj/Ref lokal hidup saat VM_NEXT()
+        #define VM_CASE(name) op_##name:
+        #define VM_NEXT() goto *dispatchTable[chunk->code[ip++]]
+        VM_NEXT();
+#else
+        #define VM_CASE(name) case OpCode::name:
+        #define VM_NEXT() goto dispatch
+        dispatch:
+        switch (static_cast<OpCode>(chunk->code[ip++])) {
+#endif
+        VM_CASE(CONST) {
+            stack.push_back(chunk->constants[readOperand()]);
+            VM_NEXT();
+        }
+        VM_CASE(NIL) {
+            stack.emplace_back();
+            VM_NEXT();
+        }
+        VM_CASE(POP) {
+            stack.pop_back();
+            VM_NEXT();
+        }
+        VM_CASE(GET_VAR) {
+            stack.push_back(lookup(readRef()));
+            if (errorPending) goto unwind;
+            VM_NEXT();
+        }
+        VM_CASE(DEFINE_VAR) {
+            SlotRef ref = readRef();
+            define(ref, pop());
+            VM_NEXT();
+        }
+        VM_CASE(INCR_VAR) {
+            SlotRef ref = readRef();
+            const Obj& val = lookup(ref);
+            if (errorPending) goto unwind;
+            if (val.isInt()) assign(ref, Obj(val.asInt() + 1));
+            VM_NEXT();
+        }
+
+        #define VM_BINARY(name, opChar, intExpr) \
+        VM_CASE(name) { \
+            Obj& l = stack[stack.size() - 2]; \
+            Obj& r = stack.back(); \
+            if (l.isInt() && r.isInt()) { \
+                int a = l.asInt(), b = r.asInt(); \
+                l = Obj(intExpr); \
+            } else { \
+                l = binaryOp(opChar, l, r); \
+            } \
+            stack.pop_back(); \
+            VM_NEXT(); \
+        }
+        VM_BINARY(ADD, '+', a + b)
+        VM_BINARY(SUB, '-', a - b)
+        VM_BINARY(MUL, '*', a * b)
+        VM_BINARY(DIV, '/', (b != 0) ? a / b : 0)
+        VM_BINARY(LT, '<', a < b)
+        VM_BINARY(GT, '>', a > b)
+        VM_BINARY(EQ, '=', a == b)
+        #undef VM_BINARY
+
+        VM_CASE(JUMP) {
+            if (Gc::pending) Gc::step();
+            ip = chunk->readOperand(ip);
+            VM_NEXT();
+        }
+        VM_CASE(JUMP_IF_FALSE) {
+            uint32_t target = readOperand();
+            if (!isTruthy(pop())) ip = target;
+            VM_NEXT();
+        }
+
+        VM_CASE(BUILD_LIST) {
+            uint32_t n = readOperand();
+            Obj list(new List(std::make_move_iterator(stack.end() - n), std::make_move_iterator(stack.end())));
+            stack.resize(stack.size() - n);
+            stack.push_back(std::move(list));
+            VM_NEXT();
+        }
+        VM_CASE(BUILD_DICT) {
+            uint32_t n = readOperand();
+            Obj dict(new Dict());
+            size_t base = stack.size() - n * 2;
+            for (size_t i = base; i < stack.size(); i += 2) {
+                if (stack[i].isString()) (*dict.asDict())[stack[i].asString()] = stack[i + 1];
+                else std::cout << "Runtime Error: Dict key must be string.\n";
+            }
+            stack.resize(base);
+            stack.push_back(std::move(dict));
+            VM_NEXT();
+        }
+        VM_CASE(INDEX) {
+            Obj& object = stack[stack.size() - 2];
+            object = indexValue(object, stack.back());
+            stack.pop_back();
+            VM_NEXT();
+        }
+
+        VM_CASE(GET_FIELD) {
+            GetExpr* node = static_cast<GetExpr*>(chunk->exprs[readOperand()]);
+            Obj& obj = stack.back();
+            obj = obj.isInstance() ? getField(obj.asInstance(), node) : Obj();
+            VM_NEXT();
+        }
+        VM_CASE(SET_FIELD) {
+            SetExpr* node = static_cast<SetExpr*>(chunk->exprs[readOperand()]);
+            Obj& val = stack.back();
+            Obj& obj = stack[stack.size() - 2];
+            if (obj.isInstance()) {
+                setField(obj.asInstance(), node, val);
+                obj = std::move(val);
+            } else {
+                std::cout << "Runtime Error: Only instances have fields.\n";
+                obj = Obj();
+            }
+            stack.pop_back();
+            VM_NEXT();
+        }
+
+        VM_CASE(CALL_NATIVE) {
+            const Builtins::Native& native = Builtins::get(readOperand());
+            uint32_t argc = readOperand();
+            bool asStatement = readOperand() != 0;
+            size_t base = stack.size() - argc;
+            Builtins::NativeFn fn = (asStatement && native.stmtFn) ? native.stmtFn : native.fn;
+            frames.back().ip = ip;
+            Obj result = fn(stack.data() + base, (int)argc);
+            if (Builtins::takeError(errorMessage)) {
+                errorPending = true;
+                goto unwind;
+            }
+            stack.resize(base);
+            stack.push_back(std::move(result));
+            VM_NEXT();
+        }
+        VM_CASE(CALL) callOp: {
+            if (Gc::pending) Gc::step();
+            FuncDecl* fn = function(readOperand());
+            uint32_t argc = readOperand();
+            size_t base = stack.size() - argc;
+            if (!fn) {
+                if (errorPending) goto unwind;
+                stack.resize(base);
+                stack.emplace_back();
+                VM_NEXT();
+            }
+            if (argc != fn->params.size()) {
+                std::cout << "Runtime Error: Function " << fn->name << " mismatch args.\n";
+                stack.resize(base);
+                stack.emplace_back();
+                VM_NEXT();
+            }
+            if (fn->memo && argc <= (uint32_t)Memo::MAX_ARGS) {
+                stack.emplace_back();
+                if (Memo::lookup(fn, &stack[base], (int)argc, stack.back())) {
+                    stack[base] = std::move(stack.back());
+                    stack.resize(base + 1);
+                    VM_NEXT();
+                }
+                stack.pop_back();
+                frames.back().ip = ip;
+                frames.push_back(CallFrame{chunkFor(fn, fn->body, true), 0, base, currentEnv, nullptr, fn});
+                currentEnv = pushFrame(fn);
+                for (size_t i = 0; i < argc; ++i) currentEnv->define((int)i, stack[base + i]);
+                chunk = frames.back().chunk;
+                ip = 0;
+                VM_NEXT();
+            }
+            if (jit && !fn->memo) {
+                stack.emplace_back();
+                if (jit->call(fn, &stack[base], stack.back())) {
+                    stack[base] = std::move(stack.back());
+                    stack.resize(base + 1);
+                    VM_NEXT();
+                }
+                stack.pop_back();
+            }
+            frames.back().ip = ip;
+            frames.push_back(CallFrame{chunkFor(fn, fn->body, true), 0, base, currentEnv, nullptr});
+            currentEnv = pushFrame(fn);
+            for (size_t i = 0; i < fn->params.size(); ++i) currentEnv->define((int)i, std::move(stack[base + i]));
+            stack.resize(base);
+            chunk = frames.back().chunk;
+            ip = 0;
+            VM_NEXT();
+        }
+        VM_CASE(TAIL_CALL) {
+            FuncDecl* fn = function(chunk->readOperand(ip));
+            if (errorPending) goto unwind;
+            uint32_t argc = chunk->readOperand(ip + sizeof(uint32_t));
+            CallFrame& frame = frames.back();
+            // Frame entry, frame init() dan memo func (argumen key ada di stack frame) lewat CALL biasa; RETURN berikutnya meneruskan hasilnya
+            if (!fn || fn->memo || frame.memo || argc != fn->params.size() || frame.constructing || frames.size() == entryDepth + 1) goto callOp;
+            ip += 2 * sizeof(uint32_t);
+            size_t base = stack.size() - argc;
+            if (jit) {
+                stack.emplace_back();
+                if (jit->call(fn, &stack[base], stack.back())) {
+                    stack[base] = std::move(stack.back());
+                    stack.resize(base + 1);
+                    VM_NEXT();
+                }
+                stack.pop_back();
+            }
+            popFrames(frameDepth - 1);
+            currentEnv = pushFrame(fn);
+            for (size_t i = 0; i < argc; ++i) currentEnv->define((int)i, std::move(stack[base + i]));
+            stack.resize(frame.stackBase);
+            frame.chunk = chunkFor(fn, fn->body, true);
+            chunk = frame.chunk;
+            ip = 0;
+            VM_NEXT();
+        }
+        VM_CASE(INVOKE) {
+            MethodCallExpr* node = static_cast<MethodCallExpr*>(chunk->exprs[readOperand()]);
+            uint32_t argc = readOperand();
+            size_t base = stack.size() - argc - 1;
+            Obj& obj = stack[base];
+            if (!obj.isInstance()) {
+                std::cout << "Runtime Error: Method call on non-instance.\n";
+                stack.resize(base);
+                stack.emplace_back();
+                VM_NEXT();
+            }
+            auto instance = obj.asInstance();
+            FuncDecl* method = findMethod(instance->klass.get(), node->method, node->cache);
+            if (!method) {
+                std::cout << "Runtime Error: Method '" << node->method << "' not found.\n";
+                stack.resize(base);
+                stack.emplace_back();
+                VM_NEXT();
+            }
+            frames.back().ip = ip;
+            frames.push_back(CallFrame{chunkFor(method, method->body, true), 0, base, currentEnv, nullptr});
+            currentEnv = pushFrame(method);
+            currentEnv->define(method->thisSlot, Obj(instance));
+            for (size_t i = 0; i < method->params.size() && i < argc; ++i) currentEnv->define((int)i, std::move(stack[base + 1 + i]));
+            stack.resize(base);
+            chunk = frames.back().chunk;
+            ip = 0;
+            VM_NEXT();
+        }
+        VM_CASE(NEW) {
+            NewExpr* node = static_cast<NewExpr*>(chunk->exprs[readOperand()]);
+            uint32_t argc = readOperand();
+            size_t base = stack.size() - argc;
+            const Obj& classObj = lookup(node->ref);
+            if (errorPending) goto unwind;
+            if (!classObj.isClass()) {
+                std::cout << "Runtime Error: '" << node->className << "' is not a class.\n";
+                stack.resize(base);
+                stack.emplace_back();
+                VM_NEXT();
+            }
+            LinkClass* klass = classObj.asClass();
+            LinkInstance* instance = new LinkInstance(); // refs naik saat masuk stack / CallFrame
+            instance->klass = klass;
+            FuncDecl* init = klass->init;
+            if (!init) {
+                stack.resize(base);
+                stack.push_back(Obj(instance));
+                VM_NEXT();
+            }
+            frames.back().ip = ip;
+            frames.push_back(CallFrame{chunkFor(init, init->body, true), 0, base, currentEnv, instance});
+            currentEnv = pushFrame(init);
+            currentEnv->define(init->thisSlot, Obj(instance));
+            for (size_t i = 0; i < init->params.size() && i < argc; ++i) currentEnv->define((int)i, std::move(stack[base + i]));
+            stack.resize(base);
+            chunk = frames.back().chunk;
+            ip = 0;
+            VM_NEXT();
+        }
+
+        VM_CASE(FOR_PREP) {
+            SlotRef ref = readRef();
+            uint32_t end = readOperand();
+            if (!stack.back().isList()) {
+                std::cout << "Runtime Error: 'For' loop expects a list/range.\n";
+                stack.pop_back();
+                ip = end;
+                VM_NEXT();
+            }
+            define(ref, Obj(0));
+            stack.push_back(Obj(0));
+            VM_NEXT();
+        }
+        VM_CASE(FOR_NEXT) {
+            SlotRef ref = readRef();
+            uint32_t end = readOperand();
+            int& i = stack.back().i;
+            List* list = stack[stack.size() - 2].asLazyList();
+            if (i < (int)list->length()) {
+                assign(ref, list->at(i));
+                i++;
+            } else {
+                stack.resize(stack.size() - 2);
+                ip = end;
+            }
+            VM_NEXT();
+        }
+        VM_CASE(RANGE_PREP) {
+            SlotRef ref = readRef();
+            uint32_t end = readOperand();
+            uint32_t argc = readOperand();
+            size_t base = stack.size() - argc;
+            int start, step, count;
+            bool valid = Builtins::rangeBounds(stack.data() + base, (int)argc, start, step, count);
+            stack.resize(base);
+            if (!valid) {
+                std::cout << "Runtime Error: 'For' loop expects a list/range.\n";
+                ip = end;
+                VM_NEXT();
+            }
+            define(ref, Obj(0));
+            stack.push_back(Obj(start));
+            stack.push_back(Obj(count));
+            stack.push_back(Obj(step));
+            VM_NEXT();
+        }
+        VM_CASE(RANGE_NEXT) {
+            SlotRef ref = readRef();
+            uint32_t end = readOperand();
+            size_t top = stack.size();
+            int& remaining = stack[top - 2].i;
+            if (remaining > 0) {
+                int& next = stack[top - 3].i;
+                assignIterator(ref, next);
+                next += stack[top - 1].i;
+                remaining--;
+            } else {
+                stack.resize(top - 3);
+                ip = end;
+            }
+            VM_NEXT();
+        }
+
+        VM_CASE(TRY_BEGIN) {
+            TryStmt* node = static_cast<TryStmt*>(chunk->stmts[readOperand()]);
+            uint32_t catchIp = readOperand();
+            handlers.push_back(TryHandler{frames.size(), stack.size(), catchIp, node, currentEnv, frameDepth});
+            VM_NEXT();
+        }
+        VM_CASE(TRY_END) {
+            handlers.pop_back();
+            VM_NEXT();
+        }
+
+        VM_CASE(EVAL_EXPR) {
+            Expr* node = chunk->exprs[readOperand()];
+            frames.back().ip = ip;
+            stack.push_back(evaluateExpr(node));
+            if (errorPending) goto unwind;
+            VM_NEXT();
+        }
+        VM_CASE(EXEC_STMT) {
+            Stmt* node = chunk->stmts[readOperand()];
+            frames.back().ip = ip;
+            if (runStatement(node) == Completion::Error) goto unwind;
+            VM_NEXT();
+        }
+
+        VM_CASE(RETURN) {
+            Obj result = pop();
+            CallFrame& frame = frames.back();
+            if (frame.memo) Memo::store(frame.memo, &stack[frame.stackBase], (int)frame.memo->params.size(), result);
+            while (handlers.size() > handlerBase && handlers.back().frameCount >= frames.size()) handlers.pop_back();
+            stack.resize(frame.stackBase);
+            currentEnv = frame.prevEnv;
+            if (frame.constructing) result = Obj(frame.constructing);
+            frames.pop_back();
+            if (frames.size() == entryDepth) return Completion::Return; // return di top-level program
+            popFrames(frameDepth - 1);
+            stack.push_back(std::move(result));
+            chunk = frames.back().chunk;
+            ip = frames.back().ip;
+            VM_NEXT();
+        }
+        VM_CASE(HALT) {
+            frames.pop_back();
+            return Completion::Normal;
+        }
+#if !defined(__GNUC__)
+        }
+#endif
+
+    unwind:
+        if (handlers.size() == handlerBase) {
+            // Tidak ada try di VM ini: bersihkan frame lalu serahkan error ke pemanggil
+            stack.resize(frames[entryDepth].stackBase);
+            currentEnv = frames[entryDepth].prevEnv;
+            frames.resize(entryDepth);
+            popFrames(frameBase);
+            return Completion::Error;
+        }
+        TryHandler handler = handlers.back();
+        handlers.pop_back();
+        frames.resize(handler.frameCount);
+        stack.resize(handler.stackSize);
+        currentEnv = handler.env;
+        popFrames(handler.frameDepth);
+        enterCatch(handler.node, takeError());
+        chunk = frames.back().chunk;
+        ip = handler.catchIp;
+        VM_NEXT();
+        #undef VM_CASE
+        #undef VM_NEXT
+    }
 };
@@ -0,0 +1,37 @@
+#include "slab.h"
+#include "types.h"
+
+namespace Slab {
+    Pool lists("list", sizeof(List));
+    Pool dicts("dict", sizeof(Dict));
+    Pool instances("instance", sizeof(LinkInstance));
+    Pool strings("string", sizeof(LinkString));
+
+    static Pool* const pools[] = {&lists, &dicts, &instances, &strings};
+
+    void Pool::grow() {
+        char* slab = static_cast<char*>(::operator new(SLAB_BYTES));
+        *reinterpret_cast<void**>(slab) = slabList;
+        slabList = slab;
+        slabs++;
+        // Header 16 byte menjaga alignment slot; slot diisi dari belakang supaya pop pertama = alamat terendah
+        size_t count = (SLAB_BYTES - 16) / slotSize;
+        for (size_t i = count; i-- > 0;) {
+            FreeSlot* slot = reinterpret_cast<FreeSlot*>(slab + 16 + i * slotSize);
+            slot->next = freeList;
+            freeList = slot;
+        }
+    }
+
+    Stats Pool::stats() const {
+#ifdef LINK_NO_SLAB
+        size_t bytes = live * slotSize;
+#else
+        size_t bytes = slabs * SLAB_BYTES;
+#endif
+        return Stats{name, slotSize, live, peak, allocs, slabs, bytes};
+    }
+
+    size_t count() { return sizeof(pools) / sizeof(pools[0]); }
+    Stats stats(size_t i) { return pools[i]->stats(); }
+}
@@ -0,0 +1,60 @@
+#!/bin/bash
+# Jalankan semua examples/**/*.link dan tests/*.link dengan walker dan VM, masing-masing
+# dengan dan tanpa --jit. Output (stdout + stderr + exit code) tiap mode harus sama dengan
+# mode pertama, dan tidak boleh ada yang mati karena signal (crash).
+# tests/deep/*.link (rekursi sangat dalam, di luar kemampuan stack C walker) hanya lewat VM.
+# Kalau ada <script>.expected di sebelahnya, stdout mode pertama juga harus sama dengan isinya.
+# Pemakaian: tests/run_examples.sh [path/ke/link]
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+LINK=$(realpath "${1:-$ROOT/link}")
+TIMEOUT=${TIMEOUT:-120}
+
+# Terlalu lama untuk walker (menit), jadi tidak bisa dibandingkan antar mode
+SKIP="examples/loop/nested_loop_teset_v2.link"
+
+ALL_MODES=("--engine=walker" "--engine=walker --jit" "--engine=vm" "--engine=vm --jit")
+VM_MODES=("--engine=vm" "--engine=vm --jit")
+
+if [ ! -x "$LINK" ]; then
+    echo "link binary not found: $LINK"
+    exit 2
+fi
+
+# Beberapa example menulis file, jadi semuanya jalan di salinan sementara
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+cp -r "$ROOT/examples" "$ROOT/tests" "$WORK/"
+
+failed=0
+total=0
+cd "$WORK"
+for file in $(find examples -name '*.link' | sort) $(ls tests/*.link tests/deep/*.link); do
+    case " $SKIP " in *" $file "*) continue ;; esac
+    case "$file" in
+        tests/deep/*) MODES=("${VM_MODES[@]}") ;;
+        *) MODES=("${ALL_MODES[@]}") ;;
+    esac
+    total=$((total + 1))
+    for i in "${!MODES[@]}"; do
+        out="$WORK/out.$i"
+        (cd "$(dirname "$file")" && timeout "$TIMEOUT" "$LINK" ${MODES[$i]} "$(basename "$file")" < /dev/null > "$out" 2>&1)
+        code=$?
+        echo "exit=$code" >> "$out"
+        if [ $code -ge 124 ]; then
+            echo "FAIL $file [${MODES[$i]}]: exit $code"
+            failed=$((failed + 1))
+        elif [ $i -eq 0 ] && [ -f "${file%.link}.expected" ] && ! sed '$d' "$out" | diff -u "${file%.link}.expected" - > "$WORK/diff"; then
+            echo "FAIL $file [${MODES[$i]}]: output differs from ${file%.link}.expected"
+            head -20 "$WORK/diff"
+            failed=$((failed + 1))
+        elif [ $i -gt 0 ] && ! diff -u "$WORK/out.0" "$out" > "$WORK/diff"; then
+            echo "FAIL $file [${MODES[$i]}]: output differs from ${MODES[0]}"
+            head -20 "$WORK/diff"
+            failed=$((failed + 1))
+        fi
+    done
+done
+
+echo "$total scripts, $failed failures"
+[ $failed -eq 0 ]